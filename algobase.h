@@ -6,6 +6,15 @@
 #include "iterator.h"
 #include "util.h"
 
+#ifdef MYSTL_PERF_HOOKS
+#include "perf.h"
+#endif
+
+// 热点路径的性能测量点，定义 MYSTL_PERF_HOOKS 时由 perf.h 提供，否则为空
+#ifndef MYSTL_PERF_HOOK
+#define MYSTL_PERF_HOOK(name)
+#endif
+
 namespace laistl {
     #ifdef max 
     #pragma message("#undefing marco max")
@@ -19,36 +28,36 @@ namespace laistl {
 
     // max 
     template <class T>
-    const T& max(const T& lhs, const T& rhs) {
+    MYSTL_CONSTEXPR20 const T& max(const T& lhs, const T& rhs) {
         return lhs < rhs ? rhs : lhs;
     }
     // 重载版本 使用函数对象 comp 代替比较操作
     template <class T, class Compare>
-    const T& max(const T& lhs, const T& rhs, Compare comp) {
+    MYSTL_CONSTEXPR20 const T& max(const T& lhs, const T& rhs, Compare comp) {
         return comp(lhs, rhs) ? rhs : lhs;
     }
 
     // min 
     template <class T>
-    const T& min(const T& lhs, const T& rhs) {
+    MYSTL_CONSTEXPR20 const T& min(const T& lhs, const T& rhs) {
         return rhs < lhs ? rhs : lhs;
     }
     // 重载版本 使用函数对象 comp 代替比较操作
     template <class T, class Compare>
-    const T& min(const T& lhs, const T& rhs, Compare comp) {
+    MYSTL_CONSTEXPR20 const T& min(const T& lhs, const T& rhs, Compare comp) {
         return comp(rhs, lhs) ? rhs : lhs;
     }
 
     // iter_swap: 将两个迭代器所指对象对调 
     template <class FIter1, class FIter2>
-    void iter_swap(FIter1 lhs, FIter2 rhs) {
+    MYSTL_CONSTEXPR20 void iter_swap(FIter1 lhs, FIter2 rhs) {
         laistl::swap(*lhs, *rhs);
     }
 
     // copy: 把[first, last) 拷贝到[result, result + (last -first)) 
     // input_iterator_tag 版本
     template <class InputIter, class OutputIter>
-    OutputIter unchecked_copy_cat(InputIter first, InputIter last, 
+    MYSTL_CONSTEXPR20 OutputIter unchecked_copy_cat(InputIter first, InputIter last, 
                                   OutputIter result, laistl::input_iterator_tag)
     {
         for (; first != last; ++first, ++result) {
@@ -59,7 +68,7 @@ namespace laistl {
 
     // random_access_iterator_tag 版本
     template <class RandomIter, class OutputIter>
-    OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, 
+    MYSTL_CONSTEXPR20 OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, 
         OutputIter result, laistl::random_access_iterator_tag) {
         for (auto n = last - first; n > 0; --n, ++first, ++result) {
             *result = *first;
@@ -68,16 +77,21 @@ namespace laistl {
     }
 
     template <class InputIter, class OutputIter>
-    OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result) {
+    MYSTL_CONSTEXPR20 OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result) {
+        MYSTL_PERF_HOOK("unchecked_copy");
         return unchecked_copy_cat(first, last, result, iterator_category(first));
     }
 
-    // trivially_copy_assignable 类型提供特化版本
+    // trivially_copy_assignable 类型提供特化版本，常量求值中不能使用 memmove，退回逐个赋值
     template <class Tp, class Up>
-    typename std::enable_if<
+    MYSTL_CONSTEXPR20 typename std::enable_if<
         std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
         std::is_trivially_copy_assignable<Up>::value, Up*>::type 
     unchecked_copy(Tp* first, Tp* last, Up* result) {
+        MYSTL_PERF_HOOK("unchecked_copy<trivial>");
+        if (laistl::is_constant_evaluated()) {
+            return unchecked_copy_cat(first, last, result, laistl::random_access_iterator_tag());
+        }
         const auto n = static_cast<size_t>(last - first);
         if (n != 0) {
             std::memmove(result, first, n * sizeof(Up));
@@ -86,14 +100,15 @@ namespace laistl {
     }
 
     template <class InputIter, class OutputIter>
-    OutputIter copy(InputIter first, InputIter last, OutputIter result) {
-        return unchecked_copy(first, last, result);
+    MYSTL_CONSTEXPR20 OutputIter copy(InputIter first, InputIter last, OutputIter result) {
+        return laistl::rewrap_iter(result, unchecked_copy(laistl::unwrap_iter(first),
+            laistl::unwrap_iter(last), laistl::unwrap_iter(result)));
     }
     
     // copy_backward: 将[first, last) 拷贝到 [result - (last - first), result) 
     // bidirectional_iterator_tag 版本 
     template <class BidirectionalIter1, class BidirectionalIter2>
-    BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first,
+    MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first,
         BidirectionalIter1 last, BidirectionalIter2 result, laistl::bidirectional_iterator_tag)
     {
         while (first != last) {
@@ -104,7 +119,7 @@ namespace laistl {
 
     // random_access_iterator_tag 版本 
     template <class RandomIter1, class RandomIter2>
-    RandomIter2 unchecked_copy_backward_cat(RandomIter1 first,
+    MYSTL_CONSTEXPR20 RandomIter2 unchecked_copy_backward_cat(RandomIter1 first,
         RandomIter1 last, RandomIter2 result, laistl::random_access_iterator_tag) 
     {
         for (auto n = last - first; n > 0; --n) {
@@ -114,7 +129,7 @@ namespace laistl {
     }
 
     template <class BidirectionalIter1, class BidirectionalIter2>
-    BidirectionalIter2 unchecked_copy_backward(BidirectionalIter1 first,
+    MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_copy_backward(BidirectionalIter1 first,
         BidirectionalIter1 last, BidirectionalIter2 result)
     {
         return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
@@ -122,10 +137,13 @@ namespace laistl {
 
     // trivially_copy_assignable 类型提供特化版本
     template <class Tp, class Up>
-    typename std::enable_if<
+    MYSTL_CONSTEXPR20 typename std::enable_if<
         std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
         std::is_trivially_copy_assignable<Up>::value, Up*>::type 
     unchecked_copy_backward(Tp* first, Tp* last, Up* result) {
+        if (laistl::is_constant_evaluated()) {
+            return unchecked_copy_backward_cat(first, last, result, laistl::random_access_iterator_tag());
+        }
         const auto n = static_cast<size_t>(last - first);
         if (n != 0) {
             result -= n;
@@ -135,14 +153,15 @@ namespace laistl {
     }
 
     template <class BidirectionalIter1, class BidirectionalIter2>
-    BidirectionalIter2 copy_backward(BidirectionalIter1 first, 
+    MYSTL_CONSTEXPR20 BidirectionalIter2 copy_backward(BidirectionalIter1 first, 
         BidirectionalIter1 last, BidirectionalIter2 result) {
-        return unchecked_copy_backward(first, last, result);
+        return laistl::rewrap_iter(result, unchecked_copy_backward(laistl::unwrap_iter(first),
+            laistl::unwrap_iter(last), laistl::unwrap_iter(result)));
     }
 
     // copy_if: 把[first, last]内满足一元操作unary_pred的元素拷贝到 result为起始的位置 
     template <class InputIter, class OutputIter, class UnaryPredicate>
-    OutputIter copy_if(InputIter first, InputIter last, OutputIter result, UnaryPredicate unary_pred)
+    MYSTL_CONSTEXPR20 OutputIter copy_if(InputIter first, InputIter last, OutputIter result, UnaryPredicate unary_pred)
     {
         for (; first != last; ++first) {
             if (unary_pred(*first)) {
@@ -154,7 +173,7 @@ namespace laistl {
 
     // copy_n: 把[first, first + n] 拷贝到 [result, result + n]上， 返回一个pair分别指向拷贝结束的尾部
     template <class InputIter, class Size, class OutputIter>
-    laistl::pair<InputIter, OutputIter> 
+    MYSTL_CONSTEXPR20 laistl::pair<InputIter, OutputIter> 
     unchecked_copy_n(InputIter first, Size n, OutputIter result, laistl::input_iterator_tag) {
         for (; n > 0; --n, ++first, ++result) {
             *result = *first;
@@ -163,14 +182,14 @@ namespace laistl {
     }
 
     template <class RandomIter, class Size, class OutputIter>
-    laistl::pair<RandomIter, OutputIter> 
+    MYSTL_CONSTEXPR20 laistl::pair<RandomIter, OutputIter> 
     unchecked_copy_n(RandomIter first, Size n, OutputIter result, laistl::random_access_iterator_tag) {
         auto last = first + n;
         return laistl::pair<RandomIter, OutputIter>(last, laistl::copy(first, last, result));
     }
 
     template <class InputIter, class Size, class OutputIter>
-    laistl::pair<InputIter, OutputIter> 
+    MYSTL_CONSTEXPR20 laistl::pair<InputIter, OutputIter> 
     copy_n(InputIter first, Size n, OutputIter result) {
         return unchecked_copy_n(first, n, result, iterator_category(first));
     }
@@ -178,7 +197,7 @@ namespace laistl {
     // move: 把[first, last] 移动到[result, result + (last - first)) 内
     // input_iterator_tag 版本 
     template <class InputIter, class OutputIter> 
-    OutputIter unchecked_move_cat(InputIter first, InputIter last, OutputIter result,
+    MYSTL_CONSTEXPR20 OutputIter unchecked_move_cat(InputIter first, InputIter last, OutputIter result,
         laistl::input_iterator_tag) 
     {
         for (; first != last; ++first, ++result) {
@@ -189,7 +208,7 @@ namespace laistl {
     
     // random_access_iterator_tag 版本 
     template <class RandomIter, class OutputIter> 
-    OutputIter unchecked_move_cat(RandomIter first, InputIter last, OutputIter result,
+    MYSTL_CONSTEXPR20 OutputIter unchecked_move_cat(RandomIter first, RandomIter last, OutputIter result,
         laistl::random_access_iterator_tag) 
     {
         for (auto n = last - first; n > 0; --n, ++first, ++result) {
@@ -199,16 +218,19 @@ namespace laistl {
     }
   
     template <class InputIter, class OutputIter> 
-    OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result) {
+    MYSTL_CONSTEXPR20 OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result) {
         return unchecked_move_cat(first, last, result, iterator_category(first));
     }
 
     // trivially_move_assignable 类型提供特化版本
     template <class Tp, class Up>
-    typename std::enable_if<
+    MYSTL_CONSTEXPR20 typename std::enable_if<
         std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
         std::is_trivially_move_assignable<Up>::value, Up*>::type 
     unchecked_move(Tp* first, Tp* last, Up* result) {
+        if (laistl::is_constant_evaluated()) {
+            return unchecked_move_cat(first, last, result, laistl::random_access_iterator_tag());
+        }
         const size_t n = static_cast<size_t>(last - first);
         if (n != 0) {
             std::memmove(result, first, n * sizeof(Up));
@@ -217,14 +239,21 @@ namespace laistl {
     }
 
     template <class InputIter, class OutputIter>
-    OutputIter move(InputIter first, InputIter last, OutputIter result) {
-        return unchecked_move(first, last, result);
+    MYSTL_CONSTEXPR20 OutputIter move(InputIter first, InputIter last, OutputIter result) {
+        return laistl::rewrap_iter(result, unchecked_move(laistl::unwrap_iter(first),
+            laistl::unwrap_iter(last), laistl::unwrap_iter(result)));
+    }
+
+    // 原生指针包装成的 move_iterator：复制即移动，转交 unchecked_move，平凡类型仍走 memmove
+    template <class Tp, class OutputIter>
+    MYSTL_CONSTEXPR20 OutputIter unchecked_copy(move_iterator<Tp*> first, move_iterator<Tp*> last, OutputIter result) {
+        return unchecked_move(first.base(), last.base(), result);
     }
 
     // move_backward: 将[first, last) 移动到 [result - (last - first), result) 
     // bidirectional_iterator_tag 版本 
     template <class BidirectionalIter1, class BidirectionalIter2>
-    BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first,
+    MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first,
         BidirectionalIter1 last, BidirectionalIter2 result, laistl::bidirectional_iterator_tag)
     {
         while (first != last) {
@@ -235,7 +264,7 @@ namespace laistl {
 
     // random_access_iterator_tag 版本 
     template <class RandomIter1, class RandomIter2>
-    RandomIter2 unchecked_move_backward_cat(RandomIter1 first,
+    MYSTL_CONSTEXPR20 RandomIter2 unchecked_move_backward_cat(RandomIter1 first,
         RandomIter1 last, RandomIter2 result, laistl::random_access_iterator_tag) 
     {
         for (auto n = last - first; n > 0; --n) {
@@ -245,7 +274,7 @@ namespace laistl {
     }
 
     template <class BidirectionalIter1, class BidirectionalIter2>
-    BidirectionalIter2 unchecked_move_backward(BidirectionalIter1 first,
+    MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_move_backward(BidirectionalIter1 first,
         BidirectionalIter1 last, BidirectionalIter2 result)
     {
         return unchecked_move_backward_cat(first, last, result, iterator_category(first));
@@ -253,10 +282,13 @@ namespace laistl {
 
     // trivially_move_assignable 类型提供特化版本
     template <class Tp, class Up>
-    typename std::enable_if<
+    MYSTL_CONSTEXPR20 typename std::enable_if<
         std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
         std::is_trivially_move_assignable<Up>::value, Up*>::type 
     unchecked_move_backward(Tp* first, Tp* last, Up* result) {
+        if (laistl::is_constant_evaluated()) {
+            return unchecked_move_backward_cat(first, last, result, laistl::random_access_iterator_tag());
+        }
         const size_t n = static_cast<size_t>(last - first);
         if (n != 0) {
             result -= n;
@@ -266,14 +298,109 @@ namespace laistl {
     }
 
     template <class BidirectionalIter1, class BidirectionalIter2>
-    BidirectionalIter2 move_backward(BidirectionalIter1 first, 
+    MYSTL_CONSTEXPR20 BidirectionalIter2 move_backward(BidirectionalIter1 first, 
         BidirectionalIter1 last, BidirectionalIter2 result) {
-        return unchecked_move_backward(first, last, result);
+        return laistl::rewrap_iter(result, unchecked_move_backward(laistl::unwrap_iter(first),
+            laistl::unwrap_iter(last), laistl::unwrap_iter(result)));
+    }
+
+    // 反向迭代器解包后得到 reverse_iterator<T*>，为平凡类型提供反向感知的版本
+    // 两端都是反向迭代器时，反向的正向复制等价于底层指针的反向复制，反之亦然，都落到 memmove
+    // 只有一端是反向迭代器时，用原生指针上的倒序循环，赋值顺序与逐个赋值时相同
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 Up* unchecked_reverse_copy(Tp* first, Tp* last, Up* result) {
+        for (; first != last; ++result) {
+            *result = *--last;
+        }
+        return result;
+    }
+
+    // 移动版本，只要求移动赋值，仅可移动的类型也能使用
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 Up* unchecked_reverse_move(Tp* first, Tp* last, Up* result) {
+        for (; first != last; ++result) {
+            *result = laistl::move(*--last);
+        }
+        return result;
+    }
+
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 typename std::enable_if<
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+        std::is_trivially_copy_assignable<Up>::value, reverse_iterator<Up*>>::type 
+    unchecked_copy(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, reverse_iterator<Up*> result) {
+        return reverse_iterator<Up*>(unchecked_copy_backward(last.base(), first.base(), result.base()));
+    }
+
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 typename std::enable_if<
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+        std::is_trivially_copy_assignable<Up>::value, Up*>::type 
+    unchecked_copy(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, Up* result) {
+        return unchecked_reverse_copy(last.base(), first.base(), result);
+    }
+
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 typename std::enable_if<
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+        std::is_trivially_copy_assignable<Up>::value, reverse_iterator<Up*>>::type 
+    unchecked_copy(Tp* first, Tp* last, reverse_iterator<Up*> result) {
+        Up* out = result.base();
+        for (; first != last; ++first) {
+            *--out = *first;
+        }
+        return reverse_iterator<Up*>(out);
+    }
+
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 typename std::enable_if<
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+        std::is_trivially_copy_assignable<Up>::value, reverse_iterator<Up*>>::type 
+    unchecked_copy_backward(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, 
+                            reverse_iterator<Up*> result) {
+        return reverse_iterator<Up*>(unchecked_copy(last.base(), first.base(), result.base()));
+    }
+
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 typename std::enable_if<
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+        std::is_trivially_move_assignable<Up>::value, reverse_iterator<Up*>>::type 
+    unchecked_move(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, reverse_iterator<Up*> result) {
+        return reverse_iterator<Up*>(unchecked_move_backward(last.base(), first.base(), result.base()));
+    }
+
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 typename std::enable_if<
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+        std::is_trivially_move_assignable<Up>::value, Up*>::type 
+    unchecked_move(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, Up* result) {
+        return unchecked_reverse_move(last.base(), first.base(), result);
+    }
+
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 typename std::enable_if<
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+        std::is_trivially_move_assignable<Up>::value, reverse_iterator<Up*>>::type 
+    unchecked_move(Tp* first, Tp* last, reverse_iterator<Up*> result) {
+        Up* out = result.base();
+        for (; first != last; ++first) {
+            *--out = laistl::move(*first);
+        }
+        return reverse_iterator<Up*>(out);
+    }
+
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 typename std::enable_if<
+        std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+        std::is_trivially_move_assignable<Up>::value, reverse_iterator<Up*>>::type 
+    unchecked_move_backward(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, 
+                            reverse_iterator<Up*> result) {
+        return reverse_iterator<Up*>(unchecked_move(last.base(), first.base(), result.base()));
     }
 
     // equal: 比较第一序列在[first, last]区间上的元素值是否和第二序列相等 
     template <class InputIter1, class InputIter2>
-    bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+    MYSTL_CONSTEXPR20 bool unchecked_equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
         for (; first1 != last1; ++first1, ++first2) {
             if (*first1 != *first2) {
                 return false;
@@ -281,9 +408,34 @@ namespace laistl {
         }
         return true;
     }
+
+    // 同一整数类型（bool 除外）的连续序列按字节比较，结果与逐个 != 相同
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 typename std::enable_if<
+        std::is_integral<typename std::remove_const<Tp>::type>::value &&
+        !std::is_same<typename std::remove_const<Tp>::type, bool>::value &&
+        std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value, bool>::type
+    unchecked_equal(Tp* first1, Tp* last1, Up* first2) {
+        if (laistl::is_constant_evaluated()) {
+            for (; first1 != last1; ++first1, ++first2) {
+                if (*first1 != *first2) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        const auto n = static_cast<size_t>(last1 - first1);
+        return n == 0 || std::memcmp(first1, first2, n * sizeof(Tp)) == 0;
+    }
+
+    template <class InputIter1, class InputIter2>
+    MYSTL_CONSTEXPR20 bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+        return unchecked_equal(laistl::unwrap_iter(first1), laistl::unwrap_iter(last1),
+                               laistl::unwrap_iter(first2));
+    }
     // 重载 equal, 使用函数对象 comp 代替比较操作 
     template <class InputIter1, class InputIter2, class Compared>
-    bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp) {
+    MYSTL_CONSTEXPR20 bool unchecked_equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp) {
         for (; first1 != last1; ++first1, ++first2) {
             if (!comp(*first1, *first2)) {
                 return false;
@@ -291,10 +443,16 @@ namespace laistl {
         }
         return true;
     }
+
+    template <class InputIter1, class InputIter2, class Compared>
+    MYSTL_CONSTEXPR20 bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp) {
+        return unchecked_equal(laistl::unwrap_iter(first1), laistl::unwrap_iter(last1),
+                               laistl::unwrap_iter(first2), comp);
+    }
     
     // fill_n: 从first 位置开始填充 n 个值
     template <class OutputIter, class Size, class T>
-    OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value) {
+    MYSTL_CONSTEXPR20 OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value) {
         for (; n > 0; --n, ++first) {
             *first = value;
         }
@@ -303,11 +461,17 @@ namespace laistl {
     
     // 为one-byte 类型提供特化版本 
     template <class Tp, class Size, class Up>
-    typename std::enable_if<
+    MYSTL_CONSTEXPR20 typename std::enable_if<
         std::is_integral<Tp>::value && sizeof(Tp) == 1 &&
         !std::is_same<Tp, bool>::value && std::is_integral<Up>::value && 
         std::is_integral<Up>::value && sizeof(Up) == 1, Tp*>::type
     unchecked_fill_n(Tp* first, Size n, Up value) {
+        if (laistl::is_constant_evaluated()) {
+            for (; n > 0; --n, ++first) {
+                *first = static_cast<Tp>(value);
+            }
+            return first;
+        }
         if (n > 0) {
             std::memset(first, (unsigned char)value, (size_t)(n));
         }
@@ -315,25 +479,25 @@ namespace laistl {
     }
     
     template <class OutputIter, class Size, class T>
-    OutputIter fill_n(OutputIter first, Size n, const T& value) {
-        return unchecked_fill_n(first, n, value);
+    MYSTL_CONSTEXPR20 OutputIter fill_n(OutputIter first, Size n, const T& value) {
+        return laistl::rewrap_iter(first, unchecked_fill_n(laistl::unwrap_iter(first), n, value));
     }
 
     // fill: 为[first, last]区间内所有元素填充新值 
     template <class ForwardIter, class T>
-    void fill_cat(ForwardIter first, ForwardIter last, const T& value, laistl::forward_iterator_tag) {
+    MYSTL_CONSTEXPR20 void fill_cat(ForwardIter first, ForwardIter last, const T& value, laistl::forward_iterator_tag) {
         for (; first != last; ++first) {
             *first = value;
         }
     }
 
     template <class RandomIter, class T>
-    void fill_cat(RandomIter first, RandomIter last, const T& value, laistl::random_access_iterator_tag) {
+    MYSTL_CONSTEXPR20 void fill_cat(RandomIter first, RandomIter last, const T& value, laistl::random_access_iterator_tag) {
         fill_n(first, last - first, value);
     }
 
     template <class ForwardIter, class T>
-    void fill(ForwardIter first, ForwardIter last, const T& value) {
+    MYSTL_CONSTEXPR20 void fill(ForwardIter first, ForwardIter last, const T& value) {
         fill_cat(first, last, value, iterator_category(first));
     }
 
@@ -344,7 +508,8 @@ namespace laistl {
     // (3)如果到达 last2 而尚未到达 last1 返回 false
     // (4)如果同时到达 last1 和 last2 返回 false
     template <class InputIter1, class InputIter2>
-    bool lexicographical_compare(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2)
+    MYSTL_CONSTEXPR20 bool unchecked_lexicographical_compare(InputIter1 first1, InputIter1 last1, 
+        InputIter2 first2, InputIter2 last2)
     {
         for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
             if (*first1 < *first2) {
@@ -356,10 +521,38 @@ namespace laistl {
         }
         return first1 == last1 && first2 != last2;
     }
+    // 针对 unsigned char 连续序列的特化版本，const 与非 const 指针都适用
+    template <class Tp, class Up>
+    MYSTL_CONSTEXPR20 typename std::enable_if<
+        std::is_same<typename std::remove_const<Tp>::type, unsigned char>::value &&
+        std::is_same<typename std::remove_const<Up>::type, unsigned char>::value, bool>::type
+    unchecked_lexicographical_compare(Tp* first1, Tp* last1, Up* first2, Up* last2)
+    {
+        if (laistl::is_constant_evaluated()) {
+            for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+                if (*first1 != *first2) {
+                    return *first1 < *first2;
+                }
+            }
+            return first1 == last1 && first2 != last2;
+        }
+        const auto len1 = last1 - first1;
+        const auto len2 = last2 - first2;
+        const auto n = static_cast<size_t>(laistl::min(len1, len2));
+        const auto result = n == 0 ? 0 : std::memcmp(first1, first2, n);
+        return result != 0 ? result < 0 : len1 < len2;
+    }
+
+    template <class InputIter1, class InputIter2>
+    MYSTL_CONSTEXPR20 bool lexicographical_compare(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2)
+    {
+        return unchecked_lexicographical_compare(laistl::unwrap_iter(first1), laistl::unwrap_iter(last1),
+                                                 laistl::unwrap_iter(first2), laistl::unwrap_iter(last2));
+    }
     // 使用函数对象 comp 代替比较操作  
     template <class InputIter1, class InputIter2, class Compred>
-    bool lexicographical_compare(InputIter1 first1, InputIter1 last1, InputIter2 first2, 
-        InputIter2 last2, Compred)
+    MYSTL_CONSTEXPR20 bool unchecked_lexicographical_compare(InputIter1 first1, InputIter1 last1, 
+        InputIter2 first2, InputIter2 last2, Compred comp)
     {
         for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
             if (comp(*first1, *first2)) {
@@ -371,30 +564,38 @@ namespace laistl {
         }
         return first1 == last1 && first2 != last2;
     }
-    // 针对 const unsigned char* 的特化版本 
-    bool lexicographical_compare(const unsigned char* first1, const unsigned char* last1, 
-        const unsigned char* first2, const unsigned char* last2) 
+
+    template <class InputIter1, class InputIter2, class Compred>
+    MYSTL_CONSTEXPR20 bool lexicographical_compare(InputIter1 first1, InputIter1 last1, InputIter2 first2, 
+        InputIter2 last2, Compred comp)
     {
-        const auto len1 = last1 - first1;
-        const auto len2 = last2 - first2;
-        const auto result = std::memcmp(first1, first2, laistl::min(len1, len2));
-        return result != 0 ? result < 0 : len1 < len2;
+        return unchecked_lexicographical_compare(laistl::unwrap_iter(first1), laistl::unwrap_iter(last1),
+                                                 laistl::unwrap_iter(first2), laistl::unwrap_iter(last2), comp);
     }
 
     // mismatch: 平行比较两个序列，找到第一处失配的元素，返回一对迭代器，分别指向两个序列中失配的元素
     template <class InputIter1, class InputIter2>
-    laistl::pair<InputIter1, InputIter2>
-    mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+    MYSTL_CONSTEXPR20 laistl::pair<InputIter1, InputIter2>
+    unchecked_mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
         while (first1 != last1 && *first1 == *first2) {
             ++first1;
             ++first2;
         }
         return laistl::pair<InputIter1, InputIter2>(first1, first2);
     }
+
+    template <class InputIter1, class InputIter2>
+    MYSTL_CONSTEXPR20 laistl::pair<InputIter1, InputIter2>
+    mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+        const auto r = unchecked_mismatch(laistl::unwrap_iter(first1), laistl::unwrap_iter(last1),
+                                          laistl::unwrap_iter(first2));
+        return laistl::pair<InputIter1, InputIter2>(laistl::rewrap_iter(first1, r.first),
+                                                    laistl::rewrap_iter(first2, r.second));
+    }
     // 使用函数对象 comp 代替比较操作  
     template <class InputIter1, class InputIter2, class Compred>
-    laistl::pair<InputIter1, InputIter2>
-    mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compred comp) {
+    MYSTL_CONSTEXPR20 laistl::pair<InputIter1, InputIter2>
+    unchecked_mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compred comp) {
         while (first1 != last1 && comp(*first1, *first2)) {
             ++first1;
             ++first2;
@@ -402,6 +603,50 @@ namespace laistl {
         return laistl::pair<InputIter1, InputIter2>(first1, first2);
     }
 
+    template <class InputIter1, class InputIter2, class Compred>
+    MYSTL_CONSTEXPR20 laistl::pair<InputIter1, InputIter2>
+    mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compred comp) {
+        const auto r = unchecked_mismatch(laistl::unwrap_iter(first1), laistl::unwrap_iter(last1),
+                                          laistl::unwrap_iter(first2), comp);
+        return laistl::pair<InputIter1, InputIter2>(laistl::rewrap_iter(first1, r.first),
+                                                    laistl::rewrap_iter(first2, r.second));
+    }
+
+    // remove_if: 把[first, last)内不满足 unary_pred 的元素依次移动到前部，返回新的尾部
+    // 只遍历一次，[返回值, last) 上的元素处于被移动后的状态，由调用者销毁
+    template <class ForwardIter, class UnaryPredicate>
+    MYSTL_CONSTEXPR20 ForwardIter remove_if(ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+        for (; first != last && !unary_pred(*first); ++first) {}
+        if (first == last) {
+            return first;
+        }
+        ForwardIter result = first;
+        for (++first; first != last; ++first) {
+            if (!unary_pred(*first)) {
+                *result = laistl::move(*first);
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    // remove: 移除[first, last)内等于 value 的元素，返回新的尾部
+    template <class ForwardIter, class T>
+    MYSTL_CONSTEXPR20 ForwardIter remove(ForwardIter first, ForwardIter last, const T& value) {
+        for (; first != last && !(*first == value); ++first) {}
+        if (first == last) {
+            return first;
+        }
+        ForwardIter result = first;
+        for (++first; first != last; ++first) {
+            if (!(*first == value)) {
+                *result = laistl::move(*first);
+                ++result;
+            }
+        }
+        return result;
+    }
+
 } /* namespace laistl */
 
 #endif /*  _ALGOBASE_H */
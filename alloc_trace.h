@@ -0,0 +1,274 @@
+#ifndef _ALLOC_TRACE_H
+#define _ALLOC_TRACE_H
+
+// laistl::alloc_trace: 记录 laistl::allocator 的分配与释放事件，供 bench/alloc_replay.cpp 离线重放
+// 定义 MYSTL_ALLOC_TRACE 后 allocator 的各个分配函数才会调用记录钩子，未定义时没有任何开销；
+// 编译进钩子后，还须调用 alloc_trace::start(path) 开始记录，stop() 结束
+//
+// 每个线程把事件写入自己的环形缓冲区，写满、线程退出或 stop() 时在全局锁下整块追加到文件
+// 文件格式: [alloc_trace_header][alloc_event]*，字节序为本机字节序
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "exceptdef.h"
+
+namespace laistl {
+    // 事件种类
+    enum class alloc_event_kind : uint8_t {
+        allocate = 1,
+        deallocate = 2
+    };
+
+    // 一个事件 32 字节；deallocate 的 size 可能为 0（调用者未提供），重放时按地址找到对应的 allocate
+    struct alloc_event {
+        uint64_t time_ns;       // 自 start() 起的纳秒数
+        uint64_t addr;          // 返回或释放的地址，只用于配对
+        uint64_t size;          // 字节数
+        uint32_t thread;        // 记录时分配的线程编号，从 1 开始
+        uint16_t align;         // 对齐要求，0 表示默认对齐
+        uint8_t  kind;          // alloc_event_kind
+        uint8_t  reserved;
+    };
+
+    struct alloc_trace_header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t event_size;
+        uint64_t reserved;
+    };
+
+    constexpr uint32_t alloc_trace_magic = 0x5254414c;  // "LATR"
+    constexpr uint16_t alloc_trace_version = 1;
+
+    namespace alloc_trace {
+        // 每个线程环形缓冲区的事件数
+        constexpr size_t buffer_events = 1024;
+
+        class thread_buffer;
+
+        struct state {
+            std::atomic<bool> enabled;
+            std::atomic<uint32_t> next_thread;
+            std::atomic<uint64_t> epoch;        // 本次记录的开始时刻
+            std::atomic<uint32_t> generation;   // 每次 start() 加一，区分不同次记录的缓冲区内容
+            std::mutex lock;                    // 保护 fd 和 buffers，先于各缓冲区的锁获取
+            int fd;
+            thread_buffer* buffers;             // 所有存活线程的缓冲区，stop() 时逐个刷出
+
+            state() : enabled(false), next_thread(0), epoch(0), generation(0), fd(-1), buffers(nullptr) {}
+        };
+
+        inline state& global() {
+            static state s;
+            return s;
+        }
+
+        inline uint64_t now_ns() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        // 把 n 个事件整块写入文件，调用者持有全局锁
+        inline void write_events(int fd, const alloc_event* events, size_t n) {
+            const char* p = reinterpret_cast<const char*>(events);
+            size_t left = n * sizeof(alloc_event);
+            while (left != 0) {
+                const ssize_t r = ::write(fd, p, left);
+                if (r < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (r <= 0) {
+                    return;     // 写入失败时丢弃本块，记录不影响被测程序
+                }
+                p += r;
+                left -= static_cast<size_t>(r);
+            }
+        }
+
+        // 线程自身的信息，平凡析构，缓冲区析构之后仍可访问
+        struct thread_info {
+            uint32_t id;
+            bool buffer_destroyed;
+        };
+
+        inline thread_info& local_info() {
+            static thread_local thread_info info = { 0, false };
+            if (info.id == 0) {
+                info.id = global().next_thread.fetch_add(1, std::memory_order_relaxed) + 1;
+            }
+            return info;
+        }
+
+        inline void fill_event(alloc_event& e, alloc_event_kind kind, const void* p, size_t bytes, size_t align) {
+            e.time_ns = now_ns() - global().epoch.load(std::memory_order_relaxed);
+            e.addr = reinterpret_cast<uintptr_t>(p);
+            e.size = bytes;
+            e.thread = local_info().id;
+            e.align = static_cast<uint16_t>(align > 0xffff ? 0xffff : align);
+            e.kind = static_cast<uint8_t>(kind);
+            e.reserved = 0;
+        }
+
+        // 线程的环形缓冲区，构造时登记到全局链表，析构时刷出剩余事件并注销
+        // 本线程写入和 stop() 从其他线程刷出都持有 lock_
+        class thread_buffer {
+        public:
+            thread_buffer() : count_(0), generation_(0), prev_(nullptr), next_(nullptr) {
+                state& s = global();
+                std::lock_guard<std::mutex> guard(s.lock);
+                next_ = s.buffers;
+                if (next_ != nullptr) {
+                    next_->prev_ = this;
+                }
+                s.buffers = this;
+            }
+
+            ~thread_buffer() {
+                flush();
+                state& s = global();
+                std::lock_guard<std::mutex> guard(s.lock);
+                if (prev_ != nullptr) {
+                    prev_->next_ = next_;
+                } else {
+                    s.buffers = next_;
+                }
+                if (next_ != nullptr) {
+                    next_->prev_ = prev_;
+                }
+                local_info().buffer_destroyed = true;
+            }
+
+            thread_buffer(const thread_buffer&) = delete;
+            thread_buffer& operator=(const thread_buffer&) = delete;
+
+            void record(alloc_event_kind kind, const void* p, size_t bytes, size_t align) {
+                bool full = false;
+                {
+                    std::lock_guard<std::mutex> guard(lock_);
+                    const uint32_t gen = global().generation.load(std::memory_order_acquire);
+                    if (gen != generation_) {
+                        count_ = 0;     // 上一次记录残留的事件属于已关闭的文件
+                        generation_ = gen;
+                    }
+                    fill_event(events_[count_], kind, p, bytes, align);
+                    full = ++count_ == buffer_events;
+                }
+                // 锁的顺序是先全局锁后缓冲区锁，写满时释放缓冲区锁再刷出
+                if (full) {
+                    flush();
+                }
+            }
+
+            void flush() {
+                state& s = global();
+                std::lock_guard<std::mutex> guard(s.lock);
+                flush_locked(s);
+            }
+
+            // 调用者持有全局锁
+            void flush_locked(state& s) {
+                std::lock_guard<std::mutex> guard(lock_);
+                if (count_ != 0 && s.fd >= 0 && generation_ == s.generation.load(std::memory_order_relaxed)) {
+                    write_events(s.fd, events_, count_);
+                }
+                count_ = 0;
+            }
+
+            thread_buffer* next() const noexcept { return next_; }
+
+        private:
+            std::mutex lock_;
+            alloc_event events_[buffer_events];
+            size_t count_;
+            uint32_t generation_;
+            thread_buffer* prev_;
+            thread_buffer* next_;
+        };
+
+        inline thread_buffer& local_buffer() {
+            static thread_local thread_buffer buffer;
+            return buffer;
+        }
+
+        // 记录一个事件，未开始记录时只有一次原子读
+        // 线程退出时缓冲区可能先于其他 thread_local 对象析构，此后的事件直接在全局锁下写入文件
+        inline void record(alloc_event_kind kind, const void* p, size_t bytes, size_t align) {
+            state& s = global();
+            if (!s.enabled.load(std::memory_order_relaxed)) {
+                return;
+            }
+            if (MYSTL_UNLIKELY(local_info().buffer_destroyed)) {
+                alloc_event e;
+                fill_event(e, kind, p, bytes, align);
+                std::lock_guard<std::mutex> guard(s.lock);
+                if (s.fd >= 0) {
+                    write_events(s.fd, &e, 1);
+                }
+                return;
+            }
+            local_buffer().record(kind, p, bytes, align);
+        }
+
+        // 开始记录到 path，已存在的文件被截断；成功返回 true
+        inline bool start(const char* path) {
+            state& s = global();
+            std::lock_guard<std::mutex> guard(s.lock);
+            if (s.fd >= 0) {
+                return false;
+            }
+            const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) {
+                return false;
+            }
+            alloc_trace_header h;
+            std::memset(&h, 0, sizeof(h));
+            h.magic = alloc_trace_magic;
+            h.version = alloc_trace_version;
+            h.event_size = sizeof(alloc_event);
+            if (::write(fd, &h, sizeof(h)) != static_cast<ssize_t>(sizeof(h))) {
+                ::close(fd);
+                return false;
+            }
+            s.fd = fd;
+            s.epoch.store(now_ns(), std::memory_order_relaxed);
+            s.generation.fetch_add(1, std::memory_order_release);
+            s.enabled.store(true, std::memory_order_release);
+            return true;
+        }
+
+        // 刷出所有存活线程缓冲区中的事件
+        inline void flush() {
+            state& s = global();
+            std::lock_guard<std::mutex> guard(s.lock);
+            for (thread_buffer* b = s.buffers; b != nullptr; b = b->next()) {
+                b->flush_locked(s);
+            }
+        }
+
+        // 结束记录：刷出所有存活线程的事件并关闭文件
+        // 与 stop() 并发的分配可能仍写入缓冲区，这些事件在下一次 start() 时被丢弃
+        inline void stop() {
+            state& s = global();
+            s.enabled.store(false, std::memory_order_release);
+            std::lock_guard<std::mutex> guard(s.lock);
+            for (thread_buffer* b = s.buffers; b != nullptr; b = b->next()) {
+                b->flush_locked(s);
+            }
+            if (s.fd >= 0) {
+                ::close(s.fd);
+                s.fd = -1;
+            }
+        }
+    } /* namespace alloc_trace */
+
+} /* namespace laistl */
+
+#endif /* _ALLOC_TRACE_H */
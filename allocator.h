@@ -1,9 +1,22 @@
-#ifndef _ALLOCATOR_H
-#define _ALLOCATOR_H
+#ifndef _LAISTL_ALLOCATOR_H
+#define _LAISTL_ALLOCATOR_H
 // 模板类 allocator, 用于管理内存的分配、释放，对象的构造、析构 
+#include <cstdint>
+#include <new>
+
 #include "construct.h"
+#include "exceptdef.h"
 #include "util.h"
 
+// 分配事件的记录钩子，定义 MYSTL_ALLOC_TRACE 时生效，见 alloc_trace.h
+#ifdef MYSTL_ALLOC_TRACE
+#include "alloc_trace.h"
+#define MYSTL_ALLOC_TRACE_EVENT(kind, ptr, bytes, align) \
+    laistl::alloc_trace::record(laistl::alloc_event_kind::kind, ptr, bytes, align)
+#else
+#define MYSTL_ALLOC_TRACE_EVENT(kind, ptr, bytes, align)
+#endif
+
 namespace laistl {
     template <class T>
     class allocator {
@@ -16,80 +29,155 @@ namespace laistl {
         using size_type = size_t;
         using difference_type = ptrdiff_t;
     public:
-        static T* allocate();
-        static T* allocate(size_type n);
+        // allocate / deallocate / construct / destroy 在 C++20 下可用于常量求值，此时改用 std::allocator 分配
+        static MYSTL_CONSTEXPR20 T* allocate();
+        static MYSTL_CONSTEXPR20 T* allocate(size_type n);
         
-        static void deallocate(T* ptr);
-        static void deallocate(T* ptr, size_type n);
+        static MYSTL_CONSTEXPR20 void deallocate(T* ptr);
+        static MYSTL_CONSTEXPR20 void deallocate(T* ptr, size_type n);
+
+        // 分配失败或 n 过大时返回 nullptr，不抛出异常
+        static T* try_allocate(size_type n) noexcept;
+
+        // 按 align 字节对齐分配，align 须为 2 的幂，须用 deallocate_aligned 释放；n 过大时抛出 length_error
+        static T* allocate_aligned(size_type n, size_type align);
+        static void deallocate_aligned(T* ptr);
 
-        static void construct(T* ptr);
-        static void construct(T* ptr, const T& value);
-        static void construct(T* ptr, T&& value);
+        static MYSTL_CONSTEXPR20 void construct(T* ptr);
+        static MYSTL_CONSTEXPR20 void construct(T* ptr, const T& value);
+        static MYSTL_CONSTEXPR20 void construct(T* ptr, T&& value);
 
         template <class... Args>
-        static void construct(T* ptr, Args&& ...args);
+        static MYSTL_CONSTEXPR20 void construct(T* ptr, Args&& ...args);
 
-        static void destroy(T* ptr);
-        static void destroy(T* first, T* last);
+        static MYSTL_CONSTEXPR20 void destroy(T* ptr);
+        static MYSTL_CONSTEXPR20 void destroy(T* first, T* last);
     };
 
     template <class T>
-    T* allocator<T>::allocate() {
-        return static_cast<T*>(::operator new(sizeof(T)));
+    MYSTL_CONSTEXPR20 T* allocator<T>::allocate() {
+    #if MYSTL_HAS_CONSTEXPR20
+        if (laistl::is_constant_evaluated()) {
+            return std::allocator<T>().allocate(1);
+        }
+    #endif
+        T* p = static_cast<T*>(::operator new(sizeof(T)));
+        MYSTL_ALLOC_TRACE_EVENT(allocate, p, sizeof(T), 0);
+        return p;
     }
 
     template <class T>
-    T* allocator<T>::allocate(size_type n) {
+    MYSTL_CONSTEXPR20 T* allocator<T>::allocate(size_type n) {
         if (n == 0) {
             return nullptr;
         }
-        return static_cast<T*>(::operator new(n * sizeof(T)));
+    #if MYSTL_HAS_CONSTEXPR20
+        if (laistl::is_constant_evaluated()) {
+            return std::allocator<T>().allocate(n);
+        }
+    #endif
+        T* p = static_cast<T*>(::operator new(n * sizeof(T)));
+        MYSTL_ALLOC_TRACE_EVENT(allocate, p, n * sizeof(T), 0);
+        return p;
     }
 
     template <class T>
-    void allocator<T>::deallocate(T* ptr) {
+    T* allocator<T>::try_allocate(size_type n) noexcept {
+        if (n == 0 || n > static_cast<size_type>(-1) / sizeof(T)) {
+            return nullptr;
+        }
+        T* p = static_cast<T*>(::operator new(n * sizeof(T), std::nothrow));
+        if (p != nullptr) {
+            MYSTL_ALLOC_TRACE_EVENT(allocate, p, n * sizeof(T), 0);
+        }
+        return p;
+    }
+
+    template <class T>
+    MYSTL_CONSTEXPR20 void allocator<T>::deallocate(T* ptr) {
         if (ptr == nullptr) return ;
+    #if MYSTL_HAS_CONSTEXPR20
+        if (laistl::is_constant_evaluated()) {
+            std::allocator<T>().deallocate(ptr, 1);
+            return;
+        }
+    #endif
+        MYSTL_ALLOC_TRACE_EVENT(deallocate, ptr, 0, 0);
         ::operator delete(ptr);
     }
 
     template <class T>
-    void allocator<T>::deallocate(T* ptr, size_type) {
+    MYSTL_CONSTEXPR20 void allocator<T>::deallocate(T* ptr, size_type n) {
         if (ptr == nullptr) return ;
+    #if MYSTL_HAS_CONSTEXPR20
+        if (laistl::is_constant_evaluated()) {
+            std::allocator<T>().deallocate(ptr, n);
+            return;
+        }
+    #endif
+        MYSTL_ALLOC_TRACE_EVENT(deallocate, ptr, n * sizeof(T), 0);
+        (void)n;
         ::operator delete(ptr);
     }
 
+    // 多申请 align + sizeof(void*) 字节，对齐后在返回地址前保存原始指针
+    template <class T>
+    T* allocator<T>::allocate_aligned(size_type n, size_type align) {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (align < alignof(void*)) {
+            align = alignof(void*);
+        }
+        THROW_LENGTH_ERROR_IF(n > (static_cast<size_type>(-1) - align - sizeof(void*)) / sizeof(T),
+                              "allocator<T>::allocate_aligned() size too big");
+        void* raw = ::operator new(n * sizeof(T) + align + sizeof(void*));
+        auto addr = reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+        addr = (addr + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        reinterpret_cast<void**>(addr)[-1] = raw;
+        MYSTL_ALLOC_TRACE_EVENT(allocate, reinterpret_cast<T*>(addr), n * sizeof(T), align);
+        return reinterpret_cast<T*>(addr);
+    }
+
+    template <class T>
+    void allocator<T>::deallocate_aligned(T* ptr) {
+        if (ptr == nullptr) return ;
+        MYSTL_ALLOC_TRACE_EVENT(deallocate, ptr, 0, 0);
+        ::operator delete(reinterpret_cast<void**>(ptr)[-1]);
+    }
+
     template <class T>
-    void allocator<T>::construct(T* ptr) {
+    MYSTL_CONSTEXPR20 void allocator<T>::construct(T* ptr) {
         laistl::construct(ptr);
     }
 
     template <class T>
-    void allocator<T>::construct(T* ptr, const T& value) {
+    MYSTL_CONSTEXPR20 void allocator<T>::construct(T* ptr, const T& value) {
         laistl::construct(ptr, value);
     }
 
     template <class T>
-    void allocator<T>::construct(T* ptr, T&& value) {
+    MYSTL_CONSTEXPR20 void allocator<T>::construct(T* ptr, T&& value) {
         laistl::construct(ptr, laistl::move(value));
     }
 
     template <class T>
     template <class ...Args>
-    void allocator<T>::construct(T* ptr, Args&& ...args) {
+    MYSTL_CONSTEXPR20 void allocator<T>::construct(T* ptr, Args&& ...args) {
         laistl::construct(ptr, laistl::forward<Args>(args)...);
     }
     
     template <class T>
-    void allocator<T>::destroy(T* ptr) {
+    MYSTL_CONSTEXPR20 void allocator<T>::destroy(T* ptr) {
         laistl::destroy(ptr);
     }
 
     template <class T>
-    void allocator<T>::destroy(T* first, T* last) {
+    MYSTL_CONSTEXPR20 void allocator<T>::destroy(T* first, T* last) {
         laistl::destroy(first, last);
     }
 
 } /* namespace laistl */
 
 
-#endif /* _ALLOCATOR_H */
+#endif /* _LAISTL_ALLOCATOR_H */
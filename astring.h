@@ -0,0 +1,525 @@
+#ifndef _ASTRING_H
+#define _ASTRING_H
+
+// 字符串类 string，带小字符串优化（SSO）
+// 对象大小为 3 个指针，短字符串直接存放在对象内，长字符串通过 allocator 分配
+// 追加、插入、赋值都经由 algobase 中 char* 的 memmove / memset 批量路径
+
+#include <cstring>
+#include <initializer_list>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "simd_search.h"
+#include "util.h"
+
+namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
+    // 类：string
+    // 短模式：首字节保存长度，其余字节保存字符（含结尾的 '\0'）
+    // 长模式：cap 字段保存分配的字节数，并借用其首字节中的一位作为长模式标记
+    class string {
+    public:
+        using allocator_type = laistl::allocator<char>;
+        using data_allocator = laistl::allocator<char>;
+
+        typedef char                                        value_type;
+        typedef char*                                       pointer;
+        typedef const char*                                 const_pointer;
+        typedef char&                                       reference;
+        typedef const char&                                 const_reference;
+        typedef size_t                                      size_type;
+        typedef ptrdiff_t                                   difference_type;
+
+        typedef char*                                       iterator;
+        typedef const char*                                 const_iterator;
+        typedef laistl::reverse_iterator<iterator>          reverse_iterator;
+        typedef laistl::reverse_iterator<const_iterator>    const_reverse_iterator;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        struct long_rep {
+            size_type   cap;        // 分配的字节数 | long_flag
+            size_type   size;
+            char*       data;
+        };
+
+        struct short_rep {
+            unsigned char   size;   // 编码后的长度，长模式标记位始终为 0
+            char            data[sizeof(long_rep) - 1];
+        };
+
+        union rep {
+            long_rep    l;
+            short_rep   s;
+        };
+
+        // 长模式标记位必须落在 cap 字段的首字节上，因此与字节序有关
+    #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        static constexpr size_type      long_flag = ~(static_cast<size_type>(-1) >> 1);
+        static constexpr unsigned char  short_mask = 0x80;
+        static constexpr unsigned       short_shift = 0;
+    #else
+        static constexpr size_type      long_flag = 1;
+        static constexpr unsigned char  short_mask = 0x01;
+        static constexpr unsigned       short_shift = 1;
+    #endif
+
+        static constexpr size_type short_cap = sizeof(long_rep) - 2;   // 不含 '\0' 的内联容量
+
+        rep rep_;
+
+    public:
+        // 构造、复制、移动、析构函数
+        string() noexcept { set_short_size(0); rep_.s.data[0] = '\0'; }
+
+        string(const char* s) { init(s, std::strlen(s)); }
+        string(const char* s, size_type n) { init(s, n); }
+        string(size_type n, char ch) { init_fill(n, ch); }
+
+        string(const string& rhs) { init(rhs.data(), rhs.size()); }
+        string(const string& rhs, size_type pos, size_type n = npos) {
+            THROW_OUT_OF_RANGE_IF(pos > rhs.size(), "string: pos out of range");
+            init(rhs.data() + pos, laistl::min(n, rhs.size() - pos));
+        }
+
+        string(string&& rhs) noexcept : rep_(rhs.rep_) {
+            rhs.set_short_size(0);
+            rhs.rep_.s.data[0] = '\0';
+        }
+
+        string(std::initializer_list<char> ilist) { init(ilist.begin(), ilist.size()); }
+
+        template <class Iter, typename std::enable_if<
+            laistl::is_input_iterator<Iter>::value, int>::type = 0>
+        string(Iter first, Iter last) {
+            set_short_size(0);
+            rep_.s.data[0] = '\0';
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        string& operator=(const string& rhs) {
+            if (this != &rhs) {
+                assign(rhs.data(), rhs.size());
+            }
+            return *this;
+        }
+
+        string& operator=(string&& rhs) noexcept {
+            if (this != &rhs) {
+                release();
+                rep_ = rhs.rep_;
+                rhs.set_short_size(0);
+                rhs.rep_.s.data[0] = '\0';
+            }
+            return *this;
+        }
+
+        string& operator=(const char* s) { return assign(s, std::strlen(s)); }
+        string& operator=(char ch) { return assign(1, ch); }
+
+        ~string() { release(); }
+
+    public:
+        // 迭代器操作
+        iterator                begin()         noexcept { return get_pointer(); }
+        const_iterator          begin()   const noexcept { return get_pointer(); }
+        iterator                end()           noexcept { return get_pointer() + size(); }
+        const_iterator          end()     const noexcept { return get_pointer() + size(); }
+
+        reverse_iterator        rbegin()        noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator  rbegin()  const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator        rend()          noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator  rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+        const_iterator          cbegin()  const noexcept { return begin(); }
+        const_iterator          cend()    const noexcept { return end(); }
+
+    public:
+        // 容量相关操作
+        bool        empty()     const noexcept { return size() == 0; }
+        size_type   size()      const noexcept { return is_long() ? rep_.l.size : short_size(); }
+        size_type   length()    const noexcept { return size(); }
+        size_type   capacity()  const noexcept { return is_long() ? long_cap() - 1 : short_cap; }
+        size_type   max_size()  const noexcept { return (static_cast<size_type>(-1) >> 1) - 1; }
+        bool        is_inline() const noexcept { return !is_long(); }
+
+        void reserve(size_type n);
+        void shrink_to_fit();
+
+    public:
+        // 访问元素操作
+        reference operator[](size_type n) {
+            MYSTL_CHECK_FAST(n <= size());
+            return get_pointer()[n];
+        }
+
+        const_reference operator[](size_type n) const {
+            MYSTL_CHECK_FAST(n <= size());
+            return get_pointer()[n];
+        }
+
+        reference at(size_type n) {
+            THROW_OUT_OF_RANGE_IF(n >= size(), "string::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const {
+            THROW_OUT_OF_RANGE_IF(n >= size(), "string::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference       front()       { MYSTL_CHECK_FAST(!empty()); return *begin(); }
+        const_reference front() const { MYSTL_CHECK_FAST(!empty()); return *begin(); }
+        reference       back()        { MYSTL_CHECK_FAST(!empty()); return *(end() - 1); }
+        const_reference back()  const { MYSTL_CHECK_FAST(!empty()); return *(end() - 1); }
+
+        const char* data()  const noexcept { return get_pointer(); }
+        char*       data()        noexcept { return get_pointer(); }
+        const char* c_str() const noexcept { return get_pointer(); }
+
+    public:
+        // 修改容器操作
+        // assign
+        string& assign(const char* s, size_type n) { return replace(0, size(), s, n); }
+        string& assign(const char* s) { return assign(s, std::strlen(s)); }
+        string& assign(const string& str) { return assign(str.data(), str.size()); }
+        string& assign(size_type n, char ch) { return replace(0, size(), n, ch); }
+
+        // append
+        string& append(const char* s, size_type n) { return replace(size(), 0, s, n); }
+        string& append(const char* s) { return append(s, std::strlen(s)); }
+        string& append(const string& str) { return append(str.data(), str.size()); }
+        string& append(size_type n, char ch) { return replace(size(), 0, n, ch); }
+
+        string& operator+=(const string& str) { return append(str); }
+        string& operator+=(const char* s) { return append(s); }
+        string& operator+=(char ch) { push_back(ch); return *this; }
+
+        void push_back(char ch);
+        void pop_back() {
+            MYSTL_CHECK_FAST(!empty());
+            set_size(size() - 1);
+        }
+
+        // insert
+        string& insert(size_type pos, const char* s, size_type n) { return replace(pos, 0, s, n); }
+        string& insert(size_type pos, const char* s) { return insert(pos, s, std::strlen(s)); }
+        string& insert(size_type pos, const string& str) { return insert(pos, str.data(), str.size()); }
+        string& insert(size_type pos, size_type n, char ch) { return replace(pos, 0, n, ch); }
+
+        iterator insert(const_iterator pos, char ch) {
+            const size_type off = pos - begin();
+            replace(off, 0, 1, ch);
+            return begin() + off;
+        }
+
+        // erase / clear
+        string& erase(size_type pos = 0, size_type n = npos) {
+            THROW_OUT_OF_RANGE_IF(pos > size(), "string: pos out of range");
+            return replace(pos, laistl::min(n, size() - pos), "", 0);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            const size_type off = first - begin();
+            erase(off, static_cast<size_type>(last - first));
+            return begin() + off;
+        }
+
+        void clear() noexcept { set_size(0); }
+
+        // replace: 把 [pos, pos + n1) 替换为 s 的前 n2 个字符 / n2 个 ch
+        string& replace(size_type pos, size_type n1, const char* s, size_type n2);
+        string& replace(size_type pos, size_type n1, size_type n2, char ch);
+
+        void resize(size_type n) { resize(n, '\0'); }
+        void resize(size_type n, char ch);
+
+        void swap(string& rhs) noexcept {
+            rep tmp = rep_;
+            rep_ = rhs.rep_;
+            rhs.rep_ = tmp;
+        }
+
+    public:
+        // 字符串操作
+        string substr(size_type pos = 0, size_type n = npos) const { return string(*this, pos, n); }
+
+        int compare(const string& rhs) const noexcept { return compare(rhs.data(), rhs.size()); }
+        int compare(const char* s) const noexcept { return compare(s, std::strlen(s)); }
+        int compare(const char* s, size_type n) const noexcept;
+
+        size_type find(char ch, size_type pos = 0) const noexcept;
+        size_type find(const char* s, size_type pos, size_type n) const noexcept;
+        size_type find(const char* s, size_type pos = 0) const noexcept { return find(s, pos, std::strlen(s)); }
+        size_type find(const string& str, size_type pos = 0) const noexcept {
+            return find(str.data(), pos, str.size());
+        }
+
+    private:
+        // helper functions
+        bool is_long() const noexcept { return (rep_.s.size & short_mask) != 0; }
+        size_type short_size() const noexcept { return rep_.s.size >> short_shift; }
+        void set_short_size(size_type n) noexcept { rep_.s.size = static_cast<unsigned char>(n << short_shift); }
+        size_type long_cap() const noexcept { return rep_.l.cap & ~long_flag; }
+
+        char* get_pointer() noexcept { return is_long() ? rep_.l.data : rep_.s.data; }
+        const char* get_pointer() const noexcept { return is_long() ? rep_.l.data : rep_.s.data; }
+
+        void set_size(size_type n) noexcept {
+            if (is_long()) {
+                rep_.l.size = n;
+            } else {
+                set_short_size(n);
+            }
+            get_pointer()[n] = '\0';
+        }
+
+        void init(const char* s, size_type n);
+        void init_fill(size_type n, char ch);
+        void release() noexcept {
+            if (is_long()) {
+                data_allocator::deallocate(rep_.l.data, long_cap());
+            }
+        }
+
+        static size_type alloc_size(size_type n) noexcept;
+        size_type recommend(size_type n) const;
+        char* make_gap(size_type pos, size_type n1, size_type n2);
+        void reallocate(size_type new_cap);
+    };
+
+    // 预留空间，只会增大容量
+    inline void string::reserve(size_type n) {
+        THROW_LENGTH_ERROR_IF(n > max_size(), "string: n can not larger than max_size()");
+        if (n > capacity()) {
+            reallocate(n);
+        }
+    }
+
+    // 放弃多余的容量，能放入对象内时回到短模式
+    inline void string::shrink_to_fit() {
+        if (!is_long()) {
+            return;
+        }
+        const size_type sz = size();
+        if (sz <= short_cap) {
+            char* old = rep_.l.data;
+            const size_type old_cap = long_cap();
+            set_short_size(sz);
+            laistl::copy(old, old + sz + 1, rep_.s.data);
+            data_allocator::deallocate(old, old_cap);
+        } else if (alloc_size(sz) < long_cap()) {
+            reallocate(sz);
+        }
+    }
+
+    inline void string::push_back(char ch) {
+        const size_type sz = size();
+        if (sz == capacity()) {
+            reallocate(recommend(sz + 1));
+        }
+        char* p = get_pointer();
+        p[sz] = ch;
+        set_size(sz + 1);
+    }
+
+    inline string& string::replace(size_type pos, size_type n1, const char* s, size_type n2) {
+        const size_type sz = size();
+        THROW_OUT_OF_RANGE_IF(pos > sz, "string: pos out of range");
+        n1 = laistl::min(n1, sz - pos);
+        const char* p = get_pointer();
+        if (n2 != 0 && s + n2 > p && s < p + sz + 1) {
+            // s 指向自身的存储，先复制一份
+            const string tmp(s, n2);
+            return replace(pos, n1, tmp.data(), n2);
+        }
+        char* hole = make_gap(pos, n1, n2);
+        laistl::copy(s, s + n2, hole);
+        return *this;
+    }
+
+    inline string& string::replace(size_type pos, size_type n1, size_type n2, char ch) {
+        THROW_OUT_OF_RANGE_IF(pos > size(), "string: pos out of range");
+        n1 = laistl::min(n1, size() - pos);
+        char* hole = make_gap(pos, n1, n2);
+        laistl::fill_n(hole, n2, ch);
+        return *this;
+    }
+
+    inline void string::resize(size_type n, char ch) {
+        const size_type sz = size();
+        if (n <= sz) {
+            set_size(n);
+        } else {
+            append(n - sz, ch);
+        }
+    }
+
+    inline int string::compare(const char* s, size_type n) const noexcept {
+        const size_type sz = size();
+        const size_type len = laistl::min(sz, n);
+        const int r = len == 0 ? 0 : std::memcmp(data(), s, len);
+        if (r != 0) {
+            return r;
+        }
+        return sz < n ? -1 : (sz > n ? 1 : 0);
+    }
+
+    inline string::size_type string::find(char ch, size_type pos) const noexcept {
+        const size_type sz = size();
+        if (pos >= sz) {
+            return npos;
+        }
+        const void* r = std::memchr(data() + pos, ch, sz - pos);
+        return r == nullptr ? npos : static_cast<const char*>(r) - data();
+    }
+
+    // find: 用首尾字节的向量比较筛选候选位置，再用 memcmp 比较
+    inline string::size_type string::find(const char* s, size_type pos, size_type n) const noexcept {
+        const size_type sz = size();
+        if (n == 0) {
+            return pos <= sz ? pos : npos;
+        }
+        if (pos >= sz || n > sz - pos) {
+            return npos;
+        }
+        const char* p = data();
+        const char* r = laistl::search_bytes(p + pos, p + sz, s, n);
+        return r == p + sz ? npos : r - p;
+    }
+
+    // helper functions
+    inline void string::init(const char* s, size_type n) {
+        char* p;
+        if (n <= short_cap) {
+            set_short_size(n);
+            p = rep_.s.data;
+        } else {
+            THROW_LENGTH_ERROR_IF(n > max_size(), "string: size too big");
+            const size_type bytes = alloc_size(n);
+            p = data_allocator::allocate(bytes);
+            rep_.l.cap = bytes | long_flag;
+            rep_.l.size = n;
+            rep_.l.data = p;
+        }
+        laistl::copy(s, s + n, p);
+        p[n] = '\0';
+    }
+
+    inline void string::init_fill(size_type n, char ch) {
+        set_short_size(0);
+        rep_.s.data[0] = '\0';
+        append(n, ch);
+    }
+
+    // alloc_size: 容纳 n 个字符和 '\0' 所需的字节数，向上取整到 16 字节（保证长模式标记位可用）
+    inline string::size_type string::alloc_size(size_type n) noexcept {
+        return (n + 1 + 15) & ~static_cast<size_type>(15);
+    }
+
+    // recommend: 容量不足时按 1.5 倍增长
+    inline string::size_type string::recommend(size_type n) const {
+        THROW_LENGTH_ERROR_IF(n > max_size(), "string: size too big");
+        const size_type cap = capacity();
+        if (cap >= max_size() / 2) {
+            return max_size();
+        }
+        return laistl::max(n, cap + cap / 2);
+    }
+
+    // make_gap: 把 [pos, pos + n1) 变成长度为 n2 的空洞并返回其起始地址，尾部元素和 '\0' 随之移动
+    inline char* string::make_gap(size_type pos, size_type n1, size_type n2) {
+        const size_type sz = size();
+        THROW_LENGTH_ERROR_IF(n2 > n1 && n2 - n1 > max_size() - sz, "string: size too big");
+        const size_type new_size = sz - n1 + n2;
+        if (new_size <= capacity()) {
+            char* p = get_pointer();
+            char* tail = p + pos + n1;
+            if (n2 > n1) {
+                laistl::copy_backward(tail, p + sz + 1, p + new_size + 1);
+            } else if (n2 < n1) {
+                laistl::copy(tail, p + sz + 1, p + pos + n2);
+            }
+            if (is_long()) {
+                rep_.l.size = new_size;
+            } else {
+                set_short_size(new_size);
+            }
+            return p + pos;
+        }
+        const size_type bytes = alloc_size(recommend(new_size));
+        char* old = get_pointer();
+        char* p = data_allocator::allocate(bytes);
+        laistl::copy(old, old + pos, p);
+        laistl::copy(old + pos + n1, old + sz + 1, p + pos + n2);
+        release();
+        rep_.l.cap = bytes | long_flag;
+        rep_.l.size = new_size;
+        rep_.l.data = p;
+        return p + pos;
+    }
+
+    // reallocate: 切换到容量至少为 new_cap 的堆存储
+    inline void string::reallocate(size_type new_cap) {
+        const size_type sz = size();
+        const size_type bytes = alloc_size(new_cap);
+        char* old = get_pointer();
+        char* p = data_allocator::allocate(bytes);
+        laistl::copy(old, old + sz + 1, p);
+        release();
+        rep_.l.cap = bytes | long_flag;
+        rep_.l.size = sz;
+        rep_.l.data = p;
+    }
+
+    // 重载运算符
+    inline string operator+(const string& lhs, const string& rhs) {
+        string tmp;
+        tmp.reserve(lhs.size() + rhs.size());
+        tmp.append(lhs).append(rhs);
+        return tmp;
+    }
+
+    inline string operator+(const string& lhs, const char* rhs) {
+        string tmp(lhs);
+        tmp.append(rhs);
+        return tmp;
+    }
+
+    inline string operator+(string&& lhs, const string& rhs) {
+        lhs.append(rhs);
+        return laistl::move(lhs);
+    }
+
+    inline string operator+(string&& lhs, const char* rhs) {
+        lhs.append(rhs);
+        return laistl::move(lhs);
+    }
+
+    inline bool operator==(const string& lhs, const string& rhs) {
+        return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+    }
+
+    inline bool operator==(const string& lhs, const char* rhs) { return lhs.compare(rhs) == 0; }
+    inline bool operator!=(const string& lhs, const string& rhs) { return !(lhs == rhs); }
+    inline bool operator!=(const string& lhs, const char* rhs) { return !(lhs == rhs); }
+    inline bool operator<(const string& lhs, const string& rhs) { return lhs.compare(rhs) < 0; }
+    inline bool operator>(const string& lhs, const string& rhs) { return rhs < lhs; }
+    inline bool operator<=(const string& lhs, const string& rhs) { return !(rhs < lhs); }
+    inline bool operator>=(const string& lhs, const string& rhs) { return !(lhs < rhs); }
+
+    // 重载 swap
+    inline void swap(string& lhs, string& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
+} /* namespace laistl */
+
+#endif /* _ASTRING_H */
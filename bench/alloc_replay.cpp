@@ -0,0 +1,326 @@
+// 重放 alloc_trace.h 记录的分配轨迹，比较各分配器后端的吞吐量、峰值 RSS 和碎片率
+// 编译: g++ -std=c++11 -O2 alloc_replay.cpp -o alloc_replay -lpthread
+// 用法: alloc_replay trace.bin [--repeat N]    重放轨迹
+//       alloc_replay --demo trace.bin          运行一段 vector 负载并记录轨迹，用于试用
+// 各线程的事件按时间戳合并后在单线程中重放；malloc 后端配合 LD_PRELOAD 可以测量 jemalloc、tcmalloc 等
+
+#define MYSTL_ALLOC_TRACE
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../algobase.h"
+#include "../allocator.h"
+#include "../vector.h"
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    // 重放用的操作：事件配对后用编号代替地址
+    struct replay_op {
+        uint32_t id;
+        uint16_t align;
+        bool alloc;
+        uint64_t size;
+    };
+
+    struct replay_trace {
+        laistl::vector<replay_op> ops;
+        size_t slots = 0;           // 分配编号的个数
+        size_t unmatched = 0;       // 找不到对应 allocate 的 deallocate
+    };
+
+    // 读取轨迹文件，按时间排序后把 deallocate 与对应的 allocate 配对
+    bool load_trace(const char* path, replay_trace& out) {
+        FILE* f = std::fopen(path, "rb");
+        if (f == nullptr) {
+            fprintf(stderr, "cannot open %s\n", path);
+            return false;
+        }
+        laistl::alloc_trace_header h;
+        if (std::fread(&h, sizeof(h), 1, f) != 1 || h.magic != laistl::alloc_trace_magic ||
+            h.version != laistl::alloc_trace_version || h.event_size != sizeof(laistl::alloc_event)) {
+            fprintf(stderr, "%s: not an alloc trace\n", path);
+            std::fclose(f);
+            return false;
+        }
+        laistl::vector<laistl::alloc_event> events;
+        laistl::alloc_event e;
+        while (std::fread(&e, sizeof(e), 1, f) == 1) {
+            events.push_back(e);
+        }
+        std::fclose(f);
+        // 各线程的事件按块写入，块之间时间交错，按时间戳稳定排序还原顺序
+        // 排序下标而不是事件本身，避免 std 算法对 laistl 类型做 ADL swap 时产生歧义
+        laistl::vector<uint32_t> order(events.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = static_cast<uint32_t>(i);
+        }
+        std::stable_sort(order.data(), order.data() + order.size(), [&events](uint32_t a, uint32_t b) {
+            return events[a].time_ns < events[b].time_ns;
+        });
+        std::unordered_map<uint64_t, replay_op> live;
+        out.ops.reserve(events.size());
+        for (uint32_t idx : order) {
+            const laistl::alloc_event& ev = events[idx];
+            if (ev.kind == static_cast<uint8_t>(laistl::alloc_event_kind::allocate)) {
+                replay_op op;
+                op.id = static_cast<uint32_t>(out.slots++);
+                op.align = ev.align;
+                op.alloc = true;
+                op.size = ev.size;
+                live[ev.addr] = op;
+                out.ops.push_back(op);
+            } else {
+                auto it = live.find(ev.addr);
+                if (it == live.end()) {
+                    ++out.unmatched;
+                    continue;
+                }
+                replay_op op = it->second;
+                op.alloc = false;
+                out.ops.push_back(op);
+                live.erase(it);
+            }
+        }
+        return true;
+    }
+
+    /*****************************************************************************************/
+    // 分配器后端
+
+    struct malloc_backend {
+        static const char* name() { return "malloc"; }
+        static void* allocate(size_t n, size_t align) {
+            if (align <= alignof(std::max_align_t)) {
+                return std::malloc(n == 0 ? 1 : n);
+            }
+            void* p = nullptr;
+            return ::posix_memalign(&p, align, n == 0 ? 1 : n) == 0 ? p : nullptr;
+        }
+        static void deallocate(void* p, size_t, size_t) { std::free(p); }
+    };
+
+    struct new_backend {
+        static const char* name() { return "operator new"; }
+        // C++11 的 operator new 没有对齐版本，超对齐的请求借用 allocate_aligned
+        static void* allocate(size_t n, size_t align) {
+            if (align <= alignof(std::max_align_t)) {
+                return ::operator new(n);
+            }
+            return laistl::allocator<char>::allocate_aligned(n, align);
+        }
+        static void deallocate(void* p, size_t, size_t align) {
+            if (align <= alignof(std::max_align_t)) {
+                ::operator delete(p);
+            } else {
+                laistl::allocator<char>::deallocate_aligned(static_cast<char*>(p));
+            }
+        }
+    };
+
+    struct laistl_backend {
+        static const char* name() { return "laistl::allocator"; }
+        static void* allocate(size_t n, size_t align) {
+            if (align == 0) {
+                return laistl::allocator<char>::allocate(n == 0 ? 1 : n);
+            }
+            return laistl::allocator<char>::allocate_aligned(n == 0 ? 1 : n, align);
+        }
+        static void deallocate(void* p, size_t n, size_t align) {
+            if (align == 0) {
+                laistl::allocator<char>::deallocate(static_cast<char*>(p), n);
+            } else {
+                laistl::allocator<char>::deallocate_aligned(static_cast<char*>(p));
+            }
+        }
+    };
+
+    /*****************************************************************************************/
+    // 重放
+
+    struct replay_result {
+        double ns_per_op;
+        double peak_rss_mb;         // 重放期间 RSS 相对重放前的峰值增量
+        double peak_live_mb;        // 同时存活的请求字节数的峰值
+        double fragmentation;       // 1 - peak_live / peak_rss，RSS 中没有被请求使用的比例
+        int ok;
+    };
+
+    size_t current_rss() {
+        FILE* f = std::fopen("/proc/self/statm", "r");
+        if (f == nullptr) {
+            return 0;
+        }
+        unsigned long size = 0, resident = 0;
+        if (std::fscanf(f, "%lu %lu", &size, &resident) != 2) {
+            resident = 0;
+        }
+        std::fclose(f);
+        return static_cast<size_t>(resident) * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    }
+
+    // 执行一遍重放；touch 为真时写入每个分配块的每一页，使 RSS 反映真实占用
+    template <class Backend>
+    void run_once(const replay_trace& t, laistl::vector<void*>& slots, bool touch,
+                  size_t base_rss, size_t& peak_rss, size_t& peak_live) {
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t live = 0;
+        for (size_t i = 0; i < t.ops.size(); ++i) {
+            const replay_op& op = t.ops[i];
+            if (op.alloc) {
+                void* p = Backend::allocate(op.size, op.align);
+                slots[op.id] = p;
+                if (touch) {
+                    for (size_t off = 0; off < op.size; off += page) {
+                        static_cast<volatile char*>(p)[off] = 1;
+                    }
+                    live += op.size;
+                    peak_live = laistl::max(peak_live, live);
+                }
+            } else {
+                Backend::deallocate(slots[op.id], op.size, op.align);
+                slots[op.id] = nullptr;
+                if (touch) {
+                    live -= op.size;
+                }
+            }
+            if (touch && (i & 1023) == 0) {
+                const size_t rss = current_rss();
+                peak_rss = laistl::max(peak_rss, rss > base_rss ? rss - base_rss : 0);
+            }
+        }
+        if (touch) {
+            const size_t rss = current_rss();
+            peak_rss = laistl::max(peak_rss, rss > base_rss ? rss - base_rss : 0);
+        }
+        // 轨迹结束时仍然存活的块在这里释放，不计入时间
+        for (const auto& op : t.ops) {
+            if (op.alloc && slots[op.id] != nullptr) {
+                Backend::deallocate(slots[op.id], op.size, op.align);
+                slots[op.id] = nullptr;
+            }
+        }
+    }
+
+    // 在子进程中重放，每个后端从相同的初始堆状态开始，RSS 互不影响
+    template <class Backend>
+    replay_result replay(const replay_trace& t, size_t repeat) {
+        replay_result res;
+        std::memset(&res, 0, sizeof(res));
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            return res;
+        }
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            ::close(fds[0]);
+            laistl::vector<void*> slots(t.slots, nullptr);
+            size_t peak_rss = 0;
+            size_t peak_live = 0;
+            const size_t base_rss = current_rss();
+            run_once<Backend>(t, slots, true, base_rss, peak_rss, peak_live);
+            double best = 1e300;
+            for (size_t r = 0; r < repeat; ++r) {
+                size_t unused_rss = 0, unused_live = 0;
+                auto start = clock_type::now();
+                run_once<Backend>(t, slots, false, 0, unused_rss, unused_live);
+                best = laistl::min(best, std::chrono::duration<double, std::nano>(clock_type::now() - start).count());
+            }
+            replay_result r;
+            r.ns_per_op = t.ops.empty() ? 0 : best / t.ops.size();
+            r.peak_rss_mb = double(peak_rss) / (1 << 20);
+            r.peak_live_mb = double(peak_live) / (1 << 20);
+            r.fragmentation = peak_rss == 0 ? 0 : 1.0 - double(peak_live) / peak_rss;
+            r.ok = 1;
+            const ssize_t w = ::write(fds[1], &r, sizeof(r));
+            ::_exit(w == static_cast<ssize_t>(sizeof(r)) ? 0 : 1);
+        }
+        ::close(fds[1]);
+        if (pid > 0) {
+            if (::read(fds[0], &res, sizeof(res)) != static_cast<ssize_t>(sizeof(res))) {
+                res.ok = 0;
+            }
+            int status = 0;
+            ::waitpid(pid, &status, 0);
+        }
+        ::close(fds[0]);
+        return res;
+    }
+
+    template <class Backend>
+    void report(const replay_trace& t, size_t repeat) {
+        const replay_result r = replay<Backend>(t, repeat);
+        if (!r.ok) {
+            printf("%-20s failed\n", Backend::name());
+            return;
+        }
+        printf("%-20s %10.2f %12.2f %14.2f %12.2f %13.1f%%\n", Backend::name(), r.ns_per_op,
+               r.ns_per_op > 0 ? 1e3 / r.ns_per_op : 0.0, r.peak_rss_mb, r.peak_live_mb,
+               r.fragmentation * 100);
+    }
+
+    /*****************************************************************************************/
+    // 示例负载：多个线程增长、复制和释放 vector
+
+    void demo_workload() {
+        auto work = [](unsigned seed) {
+            laistl::vector<laistl::vector<int>> keep;
+            unsigned x = seed;
+            for (int i = 0; i < 20000; ++i) {
+                x = x * 1103515245u + 12345u;
+                laistl::vector<int> v;
+                for (unsigned k = 0; k < (x >> 16) % 300; ++k) v.push_back(static_cast<int>(k));
+                if (x % 3 == 0) keep.push_back(v);
+                if (keep.size() > 500) keep.erase(keep.begin(), keep.begin() + 250);
+            }
+        };
+        std::thread a(work, 1u), b(work, 2u);
+        work(3u);
+        a.join();
+        b.join();
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--demo") == 0) {
+        if (!laistl::alloc_trace::start(argv[2])) {
+            fprintf(stderr, "cannot start trace %s\n", argv[2]);
+            return 1;
+        }
+        demo_workload();
+        laistl::alloc_trace::stop();
+        printf("trace written to %s\n", argv[2]);
+        return 0;
+    }
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s trace.bin [--repeat N] | --demo trace.bin\n", argv[0]);
+        return 2;
+    }
+    size_t repeat = 3;
+    if (argc == 4 && std::strcmp(argv[2], "--repeat") == 0) {
+        repeat = laistl::max<size_t>(1, std::strtoull(argv[3], nullptr, 10));
+    }
+
+    replay_trace t;
+    if (!load_trace(argv[1], t)) {
+        return 1;
+    }
+    printf("%zu ops, %zu allocations, %zu unmatched frees\n", t.ops.size(), t.slots, t.unmatched);
+    printf("%-20s %10s %12s %14s %12s %14s\n", "backend", "ns/op", "Mops/s", "peak RSS MB",
+           "peak live MB", "fragmentation");
+    report<malloc_backend>(t, repeat);
+    report<new_backend>(t, repeat);
+    report<laistl_backend>(t, repeat);
+    return 0;
+}
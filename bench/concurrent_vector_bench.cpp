@@ -0,0 +1,63 @@
+// concurrent_vector 与 mutex + vector 在多线程追加时的扩展性对比
+// 编译: g++ -std=c++11 -O2 -pthread concurrent_vector_bench.cpp -o concurrent_vector_bench
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "../concurrent_vector.h"
+#include "../vector.h"
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    size_t kItems = 1 << 22;        // 每轮追加的元素总数
+
+    struct locked_vector {
+        std::mutex mtx;
+        laistl::vector<size_t> data;
+
+        void push_back(size_t v) {
+            std::lock_guard<std::mutex> lock(mtx);
+            data.push_back(v);
+        }
+    };
+
+    template <class Fn>
+    double run(unsigned threads, Fn fn) {
+        laistl::vector<std::thread> workers;
+        auto start = clock_type::now();
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([fn, t, threads] {
+                for (size_t i = t; i < kItems; i += threads) fn(i);
+            });
+        }
+        for (auto& w : workers) w.join();
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+}
+
+// 用法: concurrent_vector_bench [max_threads] [items]
+int main(int argc, char** argv) {
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (max_threads < 2) max_threads = 2;
+    if (argc > 1) max_threads = static_cast<unsigned>(std::atoi(argv[1]));
+    if (argc > 2) kItems = std::strtoull(argv[2], nullptr, 10);
+
+    printf("%-8s %22s %22s\n", "threads", "concurrent_vector M/s", "mutex+vector M/s");
+    for (unsigned t = 1; t <= max_threads; t *= 2) {
+        laistl::concurrent_vector<size_t> cv;
+        locked_vector lv;
+        const double t1 = run(t, [&cv](size_t i) { cv.push_back(i); });
+        const double t2 = run(t, [&lv](size_t i) { lv.push_back(i); });
+        size_t sum = 0;
+        for (auto v : cv) sum += v;
+        if (sum != kItems * (kItems - 1) / 2 || lv.data.size() != kItems) {
+            printf("  checksum mismatch\n");
+        }
+        printf("%-8u %22.2f %22.2f\n", t, kItems / t1 / 1e6, kItems / t2 / 1e6);
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+// 不同加固级别下 vector 常见循环的耗时，每个级别单独编译一次：
+// 编译: for h in 0 1 2; do g++ -std=c++11 -O2 -DMYSTL_HARDENING=$h hardening_bench.cpp -o hardening_bench_$h; done
+// 运行: for h in 0 1 2; do ./hardening_bench_$h; done
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../vector.h"
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    const char* level_name() {
+        switch (MYSTL_HARDENING) {
+        case MYSTL_HARDENING_NONE:  return "none";
+        case MYSTL_HARDENING_FAST:  return "fast";
+        default:                    return "debug";
+        }
+    }
+
+    template <class Fn>
+    void run(const char* name, size_t ops, Fn fn) {
+        auto start = clock_type::now();
+        const long checksum = fn();
+        const double sec = std::chrono::duration<double>(clock_type::now() - start).count();
+        printf("%-6s %-24s %8.3f ns/op (checksum %ld)\n", level_name(), name, sec * 1e9 / ops, checksum);
+    }
+}
+
+// 用法: hardening_bench [elements] [rounds]
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 16;
+    const size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+
+    laistl::vector<int> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<int>(i * 2654435761u);
+    }
+    // 下标来自运行时数据，防止编译器证明访问不越界而删去检查
+    laistl::vector<unsigned> idx(n);
+    for (size_t i = 0; i < n; ++i) {
+        idx[i] = static_cast<unsigned>((i * 40503u) % n);
+    }
+
+    run("operator[] sequential", n * rounds, [&] {
+        long sum = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < v.size(); ++i) sum += v[i];
+        }
+        return sum;
+    });
+
+    run("operator[] indexed", n * rounds, [&] {
+        long sum = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < idx.size(); ++i) sum += v[idx[i]];
+        }
+        return sum;
+    });
+
+    run("front/back", n * rounds, [&] {
+        long sum = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < n; ++i) sum += v.front() ^ v.back() ^ static_cast<long>(i);
+        }
+        return sum;
+    });
+
+    run("push_back/pop_back", n * rounds, [&] {
+        laistl::vector<int> s;
+        s.reserve(64);
+        long sum = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < n; ++i) {
+                s.push_back(static_cast<int>(i));
+                if (s.size() == 64) {
+                    while (!s.empty()) {
+                        sum += s.back();
+                        s.pop_back();
+                    }
+                }
+            }
+        }
+        return sum;
+    });
+
+    run("insert/erase middle", rounds * 64, [&] {
+        laistl::vector<int> s(v.begin(), v.begin() + (n < 256 ? n : 256));
+        long sum = 0;
+        for (size_t r = 0; r < rounds * 64; ++r) {
+            auto it = s.insert(s.begin() + s.size() / 2, static_cast<int>(r));
+            sum += *it;
+            s.erase(it);
+        }
+        return sum;
+    });
+    return 0;
+}
@@ -0,0 +1,429 @@
+// laistl 与标准库的对比基准：vector、algobase 算法和 allocator
+// 每一项报告 ns/op、bytes/op 和每次操作的分配次数，以表格输出到终端，可选输出 JSON
+// 编译: g++ -std=c++11 -O2 laistl_bench.cpp -o laistl_bench
+// 用法: laistl_bench [--seed N|random] [--size N] [--repeat N] [--filter 子串] [--json 文件|-]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../algobase.h"
+#include "../allocator.h"
+#include "../perf.h"
+#include "../vector.h"
+
+namespace {
+    size_t g_alloc_count = 0;
+    size_t g_alloc_bytes = 0;
+}
+
+// 统计全局 operator new 的分配次数和字节数
+// 替换的 new/delete 都不内联，否则 GCC 在调用点看到 new 出来的指针交给 free，报 -Wmismatched-new-delete
+__attribute__((noinline)) void* operator new(size_t n) {
+    void* p = std::malloc(n == 0 ? 1 : n);
+    if (p == nullptr) throw std::bad_alloc();
+    ++g_alloc_count;
+    g_alloc_bytes += n;
+    return p;
+}
+
+__attribute__((noinline)) void* operator new(size_t n, const std::nothrow_t&) noexcept {
+    void* p = std::malloc(n == 0 ? 1 : n);
+    if (p != nullptr) {
+        ++g_alloc_count;
+        g_alloc_bytes += n;
+    }
+    return p;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+namespace {
+
+    struct options {
+        unsigned long long seed = 42;
+        size_t size = 10000;
+        size_t repeat = 5;
+        const char* filter = nullptr;
+        const char* json = nullptr;
+    };
+
+    struct result {
+        std::string name;
+        std::string impl;
+        size_t ops;
+        double ns_per_op;
+        double bytes_per_op;
+        double allocs_per_op;
+        double cycles_per_op;           // 硬件计数器不可用时为负
+        double instructions_per_op;
+    };
+
+    options g_opt;
+    std::vector<result> g_results;
+    volatile long g_sink = 0;
+
+    // 运行 repeat 次取最快的一次；分配统计取自最后一次，各次相同
+    template <class Fn>
+    void measure(const std::string& name, const char* impl, size_t ops, Fn fn) {
+        if (g_opt.filter != nullptr && name.find(g_opt.filter) == std::string::npos) {
+            return;
+        }
+        double best = 1e300;
+        size_t count = 0;
+        size_t bytes = 0;
+        laistl::perf::sample best_sample;
+        for (size_t r = 0; r < g_opt.repeat; ++r) {
+            const size_t count0 = g_alloc_count;
+            const size_t bytes0 = g_alloc_bytes;
+            laistl::perf::sample s;
+            {
+                laistl::perf::scope sc(s);
+                g_sink = g_sink + fn();
+            }
+            count = g_alloc_count - count0;
+            bytes = g_alloc_bytes - bytes0;
+            if (s.ns < best) {
+                best = static_cast<double>(s.ns);
+                best_sample = s;
+            }
+        }
+        result res;
+        res.name = name;
+        res.impl = impl;
+        res.ops = ops;
+        res.ns_per_op = best / ops;
+        res.bytes_per_op = double(bytes) / ops;
+        res.allocs_per_op = double(count) / ops;
+        res.cycles_per_op = best_sample.valid[laistl::perf::cycles]
+            ? double(best_sample.values[laistl::perf::cycles]) / ops : -1;
+        res.instructions_per_op = best_sample.valid[laistl::perf::instructions]
+            ? double(best_sample.values[laistl::perf::instructions]) / ops : -1;
+        g_results.push_back(res);
+    }
+
+    // 同一组随机数据供两种实现使用
+    std::vector<int> random_ints(size_t n, unsigned long long salt) {
+        std::mt19937_64 rng(g_opt.seed ^ (salt * 0x9e3779b97f4a7c15ull));
+        std::vector<int> v(n);
+        for (auto& x : v) x = static_cast<int>(rng() % 1000000);
+        return v;
+    }
+
+    std::vector<std::string> random_strings(size_t n, unsigned long long salt) {
+        std::mt19937_64 rng(g_opt.seed ^ (salt * 0x9e3779b97f4a7c15ull));
+        std::vector<std::string> v(n);
+        for (auto& s : v) s.assign(8 + rng() % 32, static_cast<char>('a' + rng() % 26));
+        return v;
+    }
+
+    /*****************************************************************************************/
+    // vector
+
+    template <class Vec>
+    void bench_vector(const char* impl) {
+        const size_t n = g_opt.size;
+        const auto ints = random_ints(n, 1);
+        const auto strs = random_strings(n, 2);
+        typedef typename Vec::template rebind_string<std::string>::type SVec;
+
+        measure("vector.push_back<int>", impl, n, [&] {
+            Vec v;
+            for (size_t i = 0; i < n; ++i) v.push_back(ints[i]);
+            return static_cast<long>(v.size()) + v[n / 2];
+        });
+
+        measure("vector.reserve+push_back<int>", impl, n, [&] {
+            Vec v;
+            v.reserve(n);
+            for (size_t i = 0; i < n; ++i) v.push_back(ints[i]);
+            return static_cast<long>(v.size()) + v[n / 2];
+        });
+
+        measure("vector.emplace_back<string>", impl, n, [&] {
+            SVec v;
+            for (size_t i = 0; i < n; ++i) v.emplace_back(strs[i].data(), strs[i].size());
+            return static_cast<long>(v.size() + v[n / 2].size());
+        });
+
+        const size_t m = n < 2000 ? n : 2000;
+        measure("vector.insert_middle<int>", impl, m, [&] {
+            Vec v;
+            for (size_t i = 0; i < m; ++i) v.insert(v.begin() + v.size() / 2, ints[i]);
+            return static_cast<long>(v.size()) + v[m / 2];
+        });
+
+        measure("vector.erase_middle<int>", impl, m, [&] {
+            Vec v(ints.data(), ints.data() + m);
+            long sum = 0;
+            while (!v.empty()) {
+                auto it = v.erase(v.begin() + v.size() / 2);
+                sum += it == v.end() ? 0 : *it;
+            }
+            return sum;
+        });
+
+        const Vec src(ints.data(), ints.data() + n);
+        const SVec ssrc(strs.data(), strs.data() + n);
+
+        measure("vector.copy<int>", impl, n, [&] {
+            Vec v(src);
+            return static_cast<long>(v.size()) + v[n / 2];
+        });
+
+        measure("vector.copy<string>", impl, n, [&] {
+            SVec v(ssrc);
+            return static_cast<long>(v.size() + v[n / 2].size());
+        });
+
+        // 每次操作移动构造一次再移动赋值回去，源在计时区外构造，各次运行状态相同
+        // 经 volatile 指针访问源，防止编译器把整个循环折叠掉
+        SVec msrc(ssrc.begin(), ssrc.begin() + 16);
+        SVec* volatile mptr = &msrc;
+        measure("vector.move<string>", impl, n, [&] {
+            long sum = 0;
+            for (size_t i = 0; i < n; ++i) {
+                SVec& a = *mptr;
+                SVec b(std::move(a));
+                sum += static_cast<long>(b.size());
+                a = std::move(b);
+            }
+            return sum;
+        });
+
+        // 目标容量预先留足，每次先清空，测的是不分配时的 assign
+        Vec dst;
+        dst.reserve(n);
+        measure("vector.assign<int>", impl, n, [&] {
+            dst.clear();
+            dst.assign(ints.data(), ints.data() + n);
+            return static_cast<long>(dst.size()) + dst[n / 2];
+        });
+
+        Vec other(src);
+        other[n - 1] += 1;
+        measure("vector.compare<int>", impl, n, [&] {
+            return static_cast<long>(src == other) + static_cast<long>(src < other);
+        });
+    }
+
+    // 让 bench_vector 能从 int 的 vector 类型得到同一实现的 string vector 类型
+    template <class T>
+    struct laistl_vec : laistl::vector<T> {
+        using laistl::vector<T>::vector;
+        template <class U> struct rebind_string { typedef laistl_vec<U> type; };
+    };
+
+    template <class T>
+    struct std_vec : std::vector<T> {
+        using std::vector<T>::vector;
+        template <class U> struct rebind_string { typedef std_vec<U> type; };
+    };
+
+    /*****************************************************************************************/
+    // algobase
+
+    struct laistl_algo {
+        template <class I, class O> static O copy(I f, I l, O r) { return laistl::copy(f, l, r); }
+        template <class I, class O> static O copy_backward(I f, I l, O r) { return laistl::copy_backward(f, l, r); }
+        template <class I, class O> static O move(I f, I l, O r) { return laistl::move(f, l, r); }
+        template <class O, class T> static O fill_n(O f, size_t n, const T& v) { return laistl::fill_n(f, n, v); }
+        template <class I, class T> static void fill(I f, I l, const T& v) { laistl::fill(f, l, v); }
+        template <class I1, class I2> static bool equal(I1 f, I1 l, I2 g) { return laistl::equal(f, l, g); }
+        template <class I1, class I2> static bool lex(I1 f1, I1 l1, I2 f2, I2 l2) {
+            return laistl::lexicographical_compare(f1, l1, f2, l2);
+        }
+        template <class I1, class I2> static I1 mismatch(I1 f, I1 l, I2 g) { return laistl::mismatch(f, l, g).first; }
+        template <class P> static laistl::reverse_iterator<P> rev(P p) { return laistl::reverse_iterator<P>(p); }
+    };
+
+    struct std_algo {
+        template <class I, class O> static O copy(I f, I l, O r) { return std::copy(f, l, r); }
+        template <class I, class O> static O copy_backward(I f, I l, O r) { return std::copy_backward(f, l, r); }
+        template <class I, class O> static O move(I f, I l, O r) { return std::move(f, l, r); }
+        template <class O, class T> static O fill_n(O f, size_t n, const T& v) { return std::fill_n(f, n, v); }
+        template <class I, class T> static void fill(I f, I l, const T& v) { std::fill(f, l, v); }
+        template <class I1, class I2> static bool equal(I1 f, I1 l, I2 g) { return std::equal(f, l, g); }
+        template <class I1, class I2> static bool lex(I1 f1, I1 l1, I2 f2, I2 l2) {
+            return std::lexicographical_compare(f1, l1, f2, l2);
+        }
+        template <class I1, class I2> static I1 mismatch(I1 f, I1 l, I2 g) { return std::mismatch(f, l, g).first; }
+        template <class P> static std::reverse_iterator<P> rev(P p) { return std::reverse_iterator<P>(p); }
+    };
+
+    template <class Algo>
+    void bench_algo(const char* impl) {
+        const size_t n = g_opt.size;
+        const auto ints = random_ints(n, 3);
+        std::vector<int> out(n);
+        std::vector<unsigned char> bytes(n), bytes2(n);
+        for (size_t i = 0; i < n; ++i) bytes[i] = bytes2[i] = static_cast<unsigned char>(ints[i]);
+        bytes2[n - 1] ^= 1;
+        const auto strs = random_strings(n / 10 + 1, 4);
+        std::vector<std::string> sout(strs.size());
+
+        measure("algo.copy<int>", impl, n, [&] {
+            return static_cast<long>(*(Algo::copy(ints.data(), ints.data() + n, out.data()) - 1));
+        });
+        measure("algo.copy<string>", impl, strs.size(), [&] {
+            return static_cast<long>(Algo::copy(strs.data(), strs.data() + strs.size(), sout.data())[-1].size());
+        });
+        measure("algo.copy_reverse<int>", impl, n, [&] {
+            return static_cast<long>(*(Algo::copy(Algo::rev(ints.data() + n), Algo::rev(ints.data()), out.data()) - 1));
+        });
+        measure("algo.copy_backward<int>", impl, n, [&] {
+            return static_cast<long>(*Algo::copy_backward(ints.data(), ints.data() + n, out.data() + n));
+        });
+        measure("algo.move<int>", impl, n, [&] {
+            return static_cast<long>(*(Algo::move(ints.data(), ints.data() + n, out.data()) - 1));
+        });
+        measure("algo.fill_n<int>", impl, n, [&] {
+            return static_cast<long>(*(Algo::fill_n(out.data(), n, 7) - 1));
+        });
+        measure("algo.fill<uchar>", impl, n, [&] {
+            Algo::fill(bytes2.data(), bytes2.data() + n - 1, static_cast<unsigned char>(3));
+            return static_cast<long>(bytes2[n / 2]);
+        });
+        for (size_t i = 0; i < n; ++i) bytes2[i] = bytes[i];
+        bytes2[n - 1] ^= 1;
+        measure("algo.equal<int>", impl, n, [&] {
+            return static_cast<long>(Algo::equal(ints.data(), ints.data() + n, ints.data()));
+        });
+        measure("algo.lexicographical_compare<uchar>", impl, n, [&] {
+            return static_cast<long>(Algo::lex(bytes.data(), bytes.data() + n, bytes2.data(), bytes2.data() + n));
+        });
+        measure("algo.mismatch<uchar>", impl, n, [&] {
+            return static_cast<long>(Algo::mismatch(bytes.data(), bytes.data() + n, bytes2.data()) - bytes.data());
+        });
+    }
+
+    /*****************************************************************************************/
+    // allocator
+
+    template <class Alloc>
+    void bench_alloc(const char* impl) {
+        const size_t n = g_opt.size;
+        const auto sizes = random_ints(n, 5);
+        Alloc a;
+        measure("alloc.allocate_deallocate", impl, n, [&] {
+            long sum = 0;
+            for (size_t i = 0; i < n; ++i) {
+                const size_t k = 1 + sizes[i] % 256;
+                int* p = a.allocate(k);
+                p[0] = static_cast<int>(i);
+                sum += p[0];
+                a.deallocate(p, k);
+            }
+            return sum;
+        });
+        std::vector<int*> ptrs(n);
+        measure("alloc.batch", impl, n, [&] {
+            for (size_t i = 0; i < n; ++i) ptrs[i] = a.allocate(1 + sizes[i] % 256);
+            for (size_t i = 0; i < n; ++i) a.deallocate(ptrs[i], 1 + sizes[i] % 256);
+            return static_cast<long>(n);
+        });
+    }
+
+    /*****************************************************************************************/
+    // 输出
+
+    void print_table() {
+        printf("%-36s %12s %12s %8s %12s %12s %10s %10s\n", "benchmark", "laistl ns/op", "std ns/op",
+               "ratio", "laistl B/op", "std B/op", "laistl a/op", "std a/op");
+        for (size_t i = 0; i < g_results.size(); ++i) {
+            const result& a = g_results[i];
+            if (a.impl != "laistl") continue;
+            const result* b = nullptr;
+            for (const auto& r : g_results) {
+                if (r.impl == "std" && r.name == a.name) b = &r;
+            }
+            if (b == nullptr) continue;
+            printf("%-36s %12.3f %12.3f %8.2f %12.2f %12.2f %10.4f %10.4f\n", a.name.c_str(),
+                   a.ns_per_op, b->ns_per_op, a.ns_per_op / b->ns_per_op,
+                   a.bytes_per_op, b->bytes_per_op, a.allocs_per_op, b->allocs_per_op);
+        }
+    }
+
+    void print_json(FILE* out) {
+        fprintf(out, "{\n  \"seed\": %llu,\n  \"size\": %zu,\n  \"repeat\": %zu,\n  \"results\": [\n",
+                g_opt.seed, g_opt.size, g_opt.repeat);
+        for (size_t i = 0; i < g_results.size(); ++i) {
+            const result& r = g_results[i];
+            fprintf(out, "    {\"name\": \"%s\", \"impl\": \"%s\", \"ops\": %zu, \"ns_per_op\": %.4f, "
+                    "\"bytes_per_op\": %.4f, \"allocs_per_op\": %.6f",
+                    r.name.c_str(), r.impl.c_str(), r.ops, r.ns_per_op, r.bytes_per_op, r.allocs_per_op);
+            if (r.cycles_per_op >= 0) {
+                fprintf(out, ", \"cycles_per_op\": %.4f", r.cycles_per_op);
+            }
+            if (r.instructions_per_op >= 0) {
+                fprintf(out, ", \"instructions_per_op\": %.4f", r.instructions_per_op);
+            }
+            fprintf(out, "}%s\n", i + 1 == g_results.size() ? "" : ",");
+        }
+        fprintf(out, "  ]\n}\n");
+    }
+
+    void parse_args(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* val = i + 1 < argc ? argv[i + 1] : nullptr;
+            if (val == nullptr) {
+                fprintf(stderr, "missing value for %s\n", arg);
+                std::exit(2);
+            }
+            if (std::strcmp(arg, "--seed") == 0) {
+                g_opt.seed = std::strcmp(val, "random") == 0 ? std::random_device()()
+                                                             : std::strtoull(val, nullptr, 10);
+            } else if (std::strcmp(arg, "--size") == 0) {
+                g_opt.size = std::max<size_t>(16, std::strtoull(val, nullptr, 10));
+            } else if (std::strcmp(arg, "--repeat") == 0) {
+                g_opt.repeat = std::max<size_t>(1, std::strtoull(val, nullptr, 10));
+            } else if (std::strcmp(arg, "--filter") == 0) {
+                g_opt.filter = val;
+            } else if (std::strcmp(arg, "--json") == 0) {
+                g_opt.json = val;
+            } else {
+                fprintf(stderr, "unknown option %s\n", arg);
+                std::exit(2);
+            }
+            ++i;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    parse_args(argc, argv);
+
+    bench_vector<laistl_vec<int>>("laistl");
+    bench_vector<std_vec<int>>("std");
+    bench_algo<laistl_algo>("laistl");
+    bench_algo<std_algo>("std");
+    bench_alloc<laistl::allocator<int>>("laistl");
+    bench_alloc<std::allocator<int>>("std");
+
+    if (g_opt.json != nullptr && std::strcmp(g_opt.json, "-") == 0) {
+        print_json(stdout);
+        return 0;
+    }
+    printf("seed %llu, size %zu, repeat %zu\n", g_opt.seed, g_opt.size, g_opt.repeat);
+    print_table();
+    if (g_opt.json != nullptr) {
+        FILE* out = std::fopen(g_opt.json, "w");
+        if (out == nullptr) {
+            fprintf(stderr, "cannot open %s\n", g_opt.json);
+            return 1;
+        }
+        print_json(out);
+        std::fclose(out);
+    }
+    return 0;
+}
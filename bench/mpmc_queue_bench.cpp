@@ -0,0 +1,98 @@
+// mpmc_queue 在不同生产者 / 消费者数量下的竞争测试，与 mutex + vector 环形队列对比
+// 编译: g++ -std=c++11 -O2 -pthread mpmc_queue_bench.cpp -o mpmc_queue_bench
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "../mpmc_queue.h"
+#include "../vector.h"
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    size_t kItems = 1 << 22;            // 每轮传递的元素总数
+    const size_t kQueueCap = 1 << 12;
+
+    // 被 mutex 保护的定长环形队列，底层存储为 vector
+    class locked_ring {
+    public:
+        explicit locked_ring(size_t n) : data_(n), head_(0), tail_(0) {}
+
+        bool try_push(size_t v) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (tail_ - head_ == data_.size()) return false;
+            data_[tail_++ % data_.size()] = v;
+            return true;
+        }
+
+        bool try_pop(size_t& v) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (tail_ == head_) return false;
+            v = data_[head_++ % data_.size()];
+            return true;
+        }
+
+    private:
+        std::mutex mtx_;
+        laistl::vector<size_t> data_;
+        size_t head_;
+        size_t tail_;
+    };
+
+    template <class Queue>
+    double run(Queue& q, unsigned producers, unsigned consumers) {
+        std::atomic<size_t> popped(0);
+        std::atomic<size_t> sum(0);
+        laistl::vector<std::thread> threads;
+        auto start = clock_type::now();
+        for (unsigned p = 0; p < producers; ++p) {
+            threads.emplace_back([&q, p, producers] {
+                for (size_t i = p; i < kItems; i += producers) {
+                    while (!q.try_push(i)) std::this_thread::yield();
+                }
+            });
+        }
+        for (unsigned c = 0; c < consumers; ++c) {
+            threads.emplace_back([&q, &popped, &sum] {
+                size_t v, local = 0;
+                while (popped.load(std::memory_order_relaxed) < kItems) {
+                    if (q.try_pop(v)) {
+                        local += v;
+                        popped.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                sum.fetch_add(local);
+            });
+        }
+        for (auto& t : threads) t.join();
+        const double sec = std::chrono::duration<double>(clock_type::now() - start).count();
+        if (sum.load() != kItems * (kItems - 1) / 2) printf("  checksum mismatch\n");
+        return sec;
+    }
+}
+
+// 用法: mpmc_queue_bench [max_threads] [items]
+int main(int argc, char** argv) {
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (max_threads < 2) max_threads = 2;
+    if (argc > 1) max_threads = static_cast<unsigned>(std::atoi(argv[1]));
+    if (argc > 2) kItems = std::strtoull(argv[2], nullptr, 10);
+
+    printf("%-6s %-6s %16s %16s\n", "prod", "cons", "mpmc Mitems/s", "locked Mitems/s");
+    for (unsigned p = 1; p <= max_threads; p *= 2) {
+        for (unsigned c = 1; c <= max_threads; c *= 2) {
+            laistl::mpmc_queue<size_t> mq(kQueueCap);
+            locked_ring lq(kQueueCap);
+            const double t1 = run(mq, p, c);
+            const double t2 = run(lq, p, c);
+            printf("%-6u %-6u %16.2f %16.2f\n", p, c, kItems / t1 / 1e6, kItems / t2 / 1e6);
+        }
+    }
+    return 0;
+}
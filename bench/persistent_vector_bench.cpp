@@ -0,0 +1,122 @@
+// 保存 N 个历史版本时 persistent_vector 与 vector 整体复制的内存和耗时对比
+// 编译: g++ -std=c++11 -O2 persistent_vector_bench.cpp -o persistent_vector_bench
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include "../persistent_vector.h"
+#include "../vector.h"
+
+namespace {
+    size_t g_live_bytes = 0;
+    size_t g_peak_bytes = 0;
+}
+
+// 统计全局 operator new 分配的字节数，在每块内存前记录大小以便 delete 时扣除
+// 替换的 new/delete 都不内联，否则 GCC 在调用点把 p - 16 当作越过 new 返回的对象，报 -Warray-bounds
+__attribute__((noinline)) void* operator new(size_t n) {
+    void* p = std::malloc(n + 16);
+    if (p == nullptr) throw std::bad_alloc();
+    *static_cast<size_t*>(p) = n;
+    g_live_bytes += n;
+    if (g_live_bytes > g_peak_bytes) g_peak_bytes = g_live_bytes;
+    return static_cast<char*>(p) + 16;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (p == nullptr) return;
+    void* raw = static_cast<char*>(p) - 16;
+    g_live_bytes -= *static_cast<size_t*>(raw);
+    std::free(raw);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    size_t kElements = 100000;
+    size_t kVersions = 1000;
+
+    template <class Fn>
+    void run(const char* name, Fn fn) {
+        const size_t base = g_live_bytes;
+        g_peak_bytes = base;
+        auto start = clock_type::now();
+        const long checksum = fn();
+        const double sec = std::chrono::duration<double>(clock_type::now() - start).count();
+        printf("%-28s %10.2f ms %12.2f MB peak %10.1f bytes/version (checksum %ld)\n",
+               name, sec * 1e3, double(g_peak_bytes - base) / (1 << 20),
+               double(g_peak_bytes - base) / kVersions, checksum);
+    }
+}
+
+// 用法: persistent_vector_bench [elements] [versions]
+// 每个版本在上一个版本的基础上修改一个随机位置，所有版本同时保留
+int main(int argc, char** argv) {
+    if (argc > 1) kElements = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2) kVersions = std::strtoull(argv[2], nullptr, 10);
+    printf("%zu elements, %zu versions\n", kElements, kVersions);
+
+    run("vector copies (set)", [] {
+        std::mt19937 rng(42);
+        laistl::vector<laistl::vector<long>> history;
+        history.reserve(kVersions + 1);
+        history.push_back(laistl::vector<long>(kElements, 1));
+        for (size_t v = 0; v < kVersions; ++v) {
+            laistl::vector<long> next(history.back());
+            next[rng() % kElements] = static_cast<long>(v);
+            history.push_back(laistl::move(next));
+        }
+        long sum = 0;
+        for (const auto& h : history) sum += h[kElements / 2];
+        return sum;
+    });
+
+    run("persistent_vector (set)", [] {
+        std::mt19937 rng(42);
+        laistl::vector<laistl::persistent_vector<long>> history;
+        history.reserve(kVersions + 1);
+        auto t = laistl::persistent_vector<long>().transient();
+        for (size_t i = 0; i < kElements; ++i) t.push_back(1);
+        history.push_back(t.persistent());
+        for (size_t v = 0; v < kVersions; ++v) {
+            history.push_back(history.back().set(rng() % kElements, static_cast<long>(v)));
+        }
+        long sum = 0;
+        for (const auto& h : history) sum += h[kElements / 2];
+        return sum;
+    });
+
+    run("vector copies (push_back)", [] {
+        laistl::vector<laistl::vector<long>> history;
+        history.reserve(kVersions + 1);
+        history.push_back(laistl::vector<long>(kElements, 1));
+        for (size_t v = 0; v < kVersions; ++v) {
+            laistl::vector<long> next(history.back());
+            next.push_back(static_cast<long>(v));
+            history.push_back(laistl::move(next));
+        }
+        long sum = 0;
+        for (const auto& h : history) sum += h.back();
+        return sum;
+    });
+
+    run("persistent_vector (push_back)", [] {
+        laistl::vector<laistl::persistent_vector<long>> history;
+        history.reserve(kVersions + 1);
+        auto t = laistl::persistent_vector<long>().transient();
+        for (size_t i = 0; i < kElements; ++i) t.push_back(1);
+        history.push_back(t.persistent());
+        for (size_t v = 0; v < kVersions; ++v) {
+            history.push_back(history.back().push_back(static_cast<long>(v)));
+        }
+        long sum = 0;
+        for (const auto& h : history) sum += h.back();
+        return sum;
+    });
+    return 0;
+}
@@ -0,0 +1,178 @@
+// spsc_ring 与 mutex + vector 的吞吐量和延迟对比
+// 编译: g++ -std=c++11 -O2 -pthread spsc_ring_bench.cpp -o spsc_ring_bench
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "../spsc_ring.h"
+#include "../vector.h"
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    size_t kItems = 1 << 24;            // 吞吐量测试传递的元素个数
+    size_t kRounds = 1 << 17;           // 延迟测试的往返次数
+    const size_t kBatch = 256;          // 批量接口每次传递的个数
+    const size_t kRingCap = 1 << 14;
+
+    // 等待对方线程时让出 CPU，核数少于 2 时也能跑完
+    inline void relax() { std::this_thread::yield(); }
+
+    double seconds_since(clock_type::time_point start) {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    void report(const char* name, size_t items, double sec) {
+        printf("%-28s %10.2f Mitems/s %8.2f ns/item\n",
+               name, items / sec / 1e6, sec * 1e9 / items);
+    }
+
+    // 被 mutex 保护的 vector，消费者一次换出全部元素
+    struct locked_vector {
+        std::mutex mtx;
+        laistl::vector<size_t> data;
+
+        void push(size_t v) {
+            std::lock_guard<std::mutex> lock(mtx);
+            data.push_back(v);
+        }
+
+        void drain(laistl::vector<size_t>& out) {
+            std::lock_guard<std::mutex> lock(mtx);
+            out.swap(data);
+        }
+    };
+
+    void bench_ring_single() {
+        laistl::spsc_ring<size_t> ring(kRingCap);
+        size_t sum = 0;
+        auto start = clock_type::now();
+        std::thread consumer([&] {
+            size_t v;
+            for (size_t i = 0; i < kItems; ) {
+                if (ring.try_pop(v)) { sum += v; ++i; } else relax();
+            }
+        });
+        for (size_t i = 0; i < kItems; ) {
+            if (ring.try_push(i)) ++i; else relax();
+        }
+        consumer.join();
+        report("spsc_ring try_push/try_pop", kItems, seconds_since(start));
+        if (sum != kItems * (kItems - 1) / 2) printf("  checksum mismatch\n");
+    }
+
+    void bench_ring_batch() {
+        laistl::spsc_ring<size_t> ring(kRingCap);
+        size_t sum = 0;
+        auto start = clock_type::now();
+        std::thread consumer([&] {
+            size_t buf[kBatch];
+            for (size_t i = 0; i < kItems; ) {
+                const size_t n = ring.pop_n(buf, kBatch);
+                if (n == 0) relax();
+                for (size_t k = 0; k < n; ++k) sum += buf[k];
+                i += n;
+            }
+        });
+        size_t src[kBatch];
+        for (size_t i = 0; i < kItems; ) {
+            const size_t want = kItems - i < kBatch ? kItems - i : kBatch;
+            for (size_t k = 0; k < want; ++k) src[k] = i + k;
+            size_t done = 0;
+            while (done < want) {
+                const size_t n = ring.push_n(src + done, want - done);
+                if (n == 0) relax();
+                done += n;
+            }
+            i += want;
+        }
+        consumer.join();
+        report("spsc_ring push_n/pop_n", kItems, seconds_since(start));
+        if (sum != kItems * (kItems - 1) / 2) printf("  checksum mismatch\n");
+    }
+
+    void bench_locked_vector() {
+        locked_vector q;
+        size_t sum = 0;
+        auto start = clock_type::now();
+        std::thread consumer([&] {
+            laistl::vector<size_t> local;
+            for (size_t i = 0; i < kItems; ) {
+                local.clear();
+                q.drain(local);
+                if (local.empty()) relax();
+                for (auto v : local) sum += v;
+                i += local.size();
+            }
+        });
+        for (size_t i = 0; i < kItems; ++i) {
+            q.push(i);
+        }
+        consumer.join();
+        report("mutex + vector", kItems, seconds_since(start));
+        if (sum != kItems * (kItems - 1) / 2) printf("  checksum mismatch\n");
+    }
+
+    // 延迟：两个队列来回传递一个令牌，取往返时间的一半
+    void latency_ring() {
+        laistl::spsc_ring<size_t> ping(64), pong(64);
+        std::thread echo([&] {
+            size_t v;
+            for (size_t i = 0; i < kRounds; ++i) {
+                while (!ping.try_pop(v)) relax();
+                while (!pong.try_push(v)) relax();
+            }
+        });
+        auto start = clock_type::now();
+        size_t v;
+        for (size_t i = 0; i < kRounds; ++i) {
+            while (!ping.try_push(i)) relax();
+            while (!pong.try_pop(v)) relax();
+        }
+        const double sec = seconds_since(start);
+        echo.join();
+        printf("%-28s %10.1f ns one-way\n", "spsc_ring latency", sec * 1e9 / kRounds / 2);
+    }
+
+    void latency_locked_vector() {
+        locked_vector ping, pong;
+        std::thread echo([&] {
+            laistl::vector<size_t> local;
+            for (size_t i = 0; i < kRounds; ) {
+                local.clear();
+                ping.drain(local);
+                if (local.empty()) relax();
+                for (auto v : local) { pong.push(v); ++i; }
+            }
+        });
+        auto start = clock_type::now();
+        laistl::vector<size_t> local;
+        for (size_t i = 0; i < kRounds; ++i) {
+            ping.push(i);
+            do {
+                local.clear();
+                pong.drain(local);
+                if (local.empty()) relax();
+            } while (local.empty());
+        }
+        const double sec = seconds_since(start);
+        echo.join();
+        printf("%-28s %10.1f ns one-way\n", "mutex + vector latency", sec * 1e9 / kRounds / 2);
+    }
+}
+
+// 用法: spsc_ring_bench [items] [rounds]
+int main(int argc, char** argv) {
+    if (argc > 1) kItems = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2) kRounds = std::strtoull(argv[2], nullptr, 10);
+    bench_ring_single();
+    bench_ring_batch();
+    bench_locked_vector();
+    latency_ring();
+    latency_locked_vector();
+    return 0;
+}
@@ -0,0 +1,110 @@
+// laistl::string 与 vector<char> 的分配次数和耗时对比
+// 编译: g++ -std=c++11 -O2 string_bench.cpp -o string_bench
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "../astring.h"
+#include "../vector.h"
+
+namespace {
+    size_t g_allocs = 0;
+    size_t g_bytes = 0;
+}
+
+// 统计全局 operator new 的调用次数和字节数
+// 替换的 new/delete 都不内联，否则 GCC 在调用点看到 new 出来的指针交给 free，报 -Wmismatched-new-delete
+__attribute__((noinline)) void* operator new(size_t n) {
+    ++g_allocs;
+    g_bytes += n;
+    if (void* p = std::malloc(n)) return p;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    size_t kMessages = 1 << 20;
+
+    // 模拟消息处理：拼出 "user:<id>" 这样的短字段和一个较长的正文
+    void make_field(char* buf, size_t& len, size_t i) {
+        len = static_cast<size_t>(std::snprintf(buf, 32, "user:%zu", i % 100000));
+    }
+
+    template <class Fn>
+    void run(const char* name, Fn fn) {
+        g_allocs = 0;
+        g_bytes = 0;
+        auto start = clock_type::now();
+        const size_t checksum = fn();
+        const double sec = std::chrono::duration<double>(clock_type::now() - start).count();
+        printf("%-20s %8.2f ns/msg %8.3f allocs/msg %10.1f bytes/msg (checksum %zu)\n",
+               name, sec * 1e9 / kMessages, double(g_allocs) / kMessages,
+               double(g_bytes) / kMessages, checksum);
+    }
+}
+
+// 用法: string_bench [messages]
+int main(int argc, char** argv) {
+    if (argc > 1) kMessages = std::strtoull(argv[1], nullptr, 10);
+    static const char body[] = "payload-with-more-than-twenty-two-characters";
+
+    run("string short", [] {
+        size_t sum = 0;
+        char buf[32];
+        size_t len;
+        for (size_t i = 0; i < kMessages; ++i) {
+            make_field(buf, len, i);
+            laistl::string s(buf, len);
+            s.append("#", 1);
+            sum += s.size();
+        }
+        return sum;
+    });
+
+    run("vector<char> short", [] {
+        size_t sum = 0;
+        char buf[32];
+        size_t len;
+        for (size_t i = 0; i < kMessages; ++i) {
+            make_field(buf, len, i);
+            laistl::vector<char> s(buf, buf + len);
+            s.push_back('#');
+            sum += s.size();
+        }
+        return sum;
+    });
+
+    run("string long", [] {
+        size_t sum = 0;
+        char buf[32];
+        size_t len;
+        for (size_t i = 0; i < kMessages; ++i) {
+            make_field(buf, len, i);
+            laistl::string s(buf, len);
+            s.append(body, sizeof(body) - 1);
+            sum += s.size();
+        }
+        return sum;
+    });
+
+    run("vector<char> long", [] {
+        size_t sum = 0;
+        char buf[32];
+        size_t len;
+        for (size_t i = 0; i < kMessages; ++i) {
+            make_field(buf, len, i);
+            laistl::vector<char> s(buf, buf + len);
+            s.insert(s.end(), body, body + sizeof(body) - 1);
+            sum += s.size();
+        }
+        return sum;
+    });
+    return 0;
+}
@@ -0,0 +1,335 @@
+#ifndef _CONCURRENT_VECTOR_H
+#define _CONCURRENT_VECTOR_H
+
+// 可并发增长的分段 vector
+// 元素存放在大小按几何级数增长的段中，已有元素永不搬移，下标和引用在其他线程追加时保持有效
+
+#include <atomic>
+#include <cstring>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
+    // 模板类：concurrent_vector
+    // 第 k 段容纳 first_segment_size << k 个元素，下标 i 所在的段由 (i + first_segment_size) 的最高位决定
+    // push_back / grow_by 可以被多个线程同时调用；元素在构造它的调用返回之后才可被其他线程安全读取，
+    // size() 可能包含其他线程正在构造的元素
+    // 每段末尾附带每个元素一个字节的构造标记；构造时抛出异常的下标仍计入 size()，但不会被析构，也不应被访问
+    // clear / 析构 不能与其他操作并发
+    template <class T>
+    class concurrent_vector {
+    public:
+        using allocator_type = laistl::allocator<T>;
+        using data_allocator = laistl::allocator<T>;
+
+        typedef typename allocator_type::value_type         value_type;
+        typedef typename allocator_type::pointer            pointer;
+        typedef typename allocator_type::const_pointer      const_pointer;
+        typedef typename allocator_type::reference          reference;
+        typedef typename allocator_type::const_reference    const_reference;
+        typedef typename allocator_type::size_type          size_type;
+        typedef typename allocator_type::difference_type    difference_type;
+
+        template <class Ref, class Ptr>
+        class seg_iterator;
+
+        typedef seg_iterator<reference, pointer>                iterator;
+        typedef seg_iterator<const_reference, const_pointer>    const_iterator;
+
+    private:
+        static constexpr size_type first_segment_log = 3;
+        static constexpr size_type first_segment_size = size_type(1) << first_segment_log;
+        static constexpr size_type max_segments = sizeof(size_type) * 8 - first_segment_log;
+
+        std::atomic<pointer> segments_[max_segments];   // 段表，不会重新分配
+        alignas(cache_line_size) std::atomic<size_type> size_;  // 已占用的下标数
+
+    public:
+        // 构造、析构函数
+        concurrent_vector() noexcept : size_(0) { init_segments(); }
+        explicit concurrent_vector(size_type n) : size_(0) {
+            init_segments();
+            grow_by(n);
+        }
+        concurrent_vector(size_type n, const value_type& value) : size_(0) {
+            init_segments();
+            grow_by(n, value);
+        }
+
+        concurrent_vector(const concurrent_vector&) = delete;
+        concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+        ~concurrent_vector() {
+            clear();
+            for (size_type k = 0; k < max_segments; ++k) {
+                data_allocator::deallocate(segments_[k].load(std::memory_order_relaxed),
+                                           segment_alloc_size(k));
+            }
+        }
+
+    public:
+        // 迭代器操作
+        iterator        begin()         noexcept { return iterator(this, 0); }
+        const_iterator  begin()   const noexcept { return const_iterator(this, 0); }
+        iterator        end()           noexcept { return iterator(this, size()); }
+        const_iterator  end()     const noexcept { return const_iterator(this, size()); }
+        const_iterator  cbegin()  const noexcept { return begin(); }
+        const_iterator  cend()    const noexcept { return end(); }
+
+    public:
+        // 容器操作
+        bool empty()            const noexcept { return size() == 0; }
+        size_type size()        const noexcept { return size_.load(std::memory_order_acquire); }
+        size_type capacity()    const noexcept;
+        // 下标上限留出余量，使最大的段连同构造标记的字节数仍在 PTRDIFF_MAX 以内
+        size_type max_size()    const noexcept {
+            return (size_type(1) << (sizeof(size_type) * 8 - 2)) / (sizeof(T) + 1);
+        }
+        void reserve(size_type n);
+
+    public:
+        // 访问元素操作
+        reference operator[](size_type n) {
+            MYSTL_CHECK_FAST(n < size());
+            return *element_at(n);
+        }
+
+        const_reference operator[](size_type n) const {
+            MYSTL_CHECK_FAST(n < size());
+            return *element_at(n);
+        }
+
+        reference at(size_type n) {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "concurrent_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "concurrent_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+    public:
+        // 修改容器操作，返回新元素的下标
+        size_type push_back(const value_type& value) { return emplace_back(value); }
+        size_type push_back(value_type&& value) { return emplace_back(laistl::move(value)); }
+
+        template <class... Args>
+        size_type emplace_back(Args&& ...args);
+
+        // 一次性占用 n 个连续下标，返回第一个下标
+        size_type grow_by(size_type n) { return grow_by(n, value_type()); }
+        size_type grow_by(size_type n, const value_type& value);
+
+        void clear();
+
+    private:
+        // helper functions
+        void init_segments() noexcept;
+
+        static size_type segment_size(size_type k) noexcept { return first_segment_size << k; }
+        static size_type segment_base(size_type k) noexcept { return segment_size(k) - first_segment_size; }
+        static size_type segment_index_of(size_type n) noexcept;
+
+        // 段的元素区之后紧跟构造标记区，一起分配
+        static size_type segment_alloc_size(size_type k) noexcept {
+            return segment_size(k) + (segment_size(k) + sizeof(T) - 1) / sizeof(T);
+        }
+        static unsigned char* constructed_flags(pointer seg, size_type k) noexcept {
+            return reinterpret_cast<unsigned char*>(seg + segment_size(k));
+        }
+
+        pointer element_at(size_type n) const noexcept;
+        pointer ensure_segment(size_type k);
+        size_type claim(size_type count);
+    };
+
+    // 随机访问迭代器，保存容器指针和下标
+    template <class T>
+    template <class Ref, class Ptr>
+    class concurrent_vector<T>::seg_iterator
+        : public laistl::iterator<laistl::random_access_iterator_tag, T, ptrdiff_t, Ptr, Ref> {
+    private:
+        const concurrent_vector* vec_;
+        size_type idx_;
+    public:
+        using self = seg_iterator<Ref, Ptr>;
+
+        seg_iterator() : vec_(nullptr), idx_(0) {}
+        seg_iterator(const concurrent_vector* v, size_type i) : vec_(v), idx_(i) {}
+        // 允许 iterator 转换为 const_iterator
+        seg_iterator(const iterator& rhs) : vec_(rhs.container()), idx_(rhs.index()) {}
+
+        const concurrent_vector* container() const { return vec_; }
+        size_type index() const { return idx_; }
+
+        Ref operator*() const { return *vec_->element_at(idx_); }
+        Ptr operator->() const { return vec_->element_at(idx_); }
+        Ref operator[](difference_type n) const { return *vec_->element_at(idx_ + n); }
+
+        self& operator++() { ++idx_; return *this; }
+        self operator++(int) { self tmp = *this; ++idx_; return tmp; }
+        self& operator--() { --idx_; return *this; }
+        self operator--(int) { self tmp = *this; --idx_; return tmp; }
+
+        self& operator+=(difference_type n) { idx_ += n; return *this; }
+        self& operator-=(difference_type n) { idx_ -= n; return *this; }
+        self operator+(difference_type n) const { return self(vec_, idx_ + n); }
+        self operator-(difference_type n) const { return self(vec_, idx_ - n); }
+        difference_type operator-(const self& rhs) const {
+            return static_cast<difference_type>(idx_) - static_cast<difference_type>(rhs.idx_);
+        }
+
+        bool operator==(const self& rhs) const { return idx_ == rhs.idx_; }
+        bool operator!=(const self& rhs) const { return idx_ != rhs.idx_; }
+        bool operator<(const self& rhs) const { return idx_ < rhs.idx_; }
+        bool operator>(const self& rhs) const { return rhs < *this; }
+        bool operator<=(const self& rhs) const { return !(rhs < *this); }
+        bool operator>=(const self& rhs) const { return !(*this < rhs); }
+    };
+
+    // 已分配段的总容量
+    template <class T>
+    typename concurrent_vector<T>::size_type
+    concurrent_vector<T>::capacity() const noexcept {
+        size_type k = 0;
+        while (k < max_segments && segments_[k].load(std::memory_order_acquire) != nullptr) {
+            ++k;
+        }
+        return segment_base(k);
+    }
+
+    // 预先分配能容纳 n 个元素的段
+    template <class T>
+    void concurrent_vector<T>::reserve(size_type n) {
+        if (n == 0) {
+            return;
+        }
+        THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in concurrent_vector<T>::reserve(n)");
+        const size_type last = segment_index_of(n - 1);
+        for (size_type k = 0; k <= last; ++k) {
+            ensure_segment(k);
+        }
+    }
+
+    // 在尾部就地构造元素：原子地占用一个下标，再在对应的段中构造
+    template <class T>
+    template <class ...Args>
+    typename concurrent_vector<T>::size_type
+    concurrent_vector<T>::emplace_back(Args&& ...args) {
+        const size_type n = claim(1);
+        const size_type k = segment_index_of(n);
+        pointer seg = ensure_segment(k);
+        data_allocator::construct(seg + (n - segment_base(k)), laistl::forward<Args>(args)...);
+        constructed_flags(seg, k)[n - segment_base(k)] = 1;
+        return n;
+    }
+
+    // 占用 [n, n + count) 下标并逐段填充
+    template <class T>
+    typename concurrent_vector<T>::size_type
+    concurrent_vector<T>::grow_by(size_type count, const value_type& value) {
+        const size_type first = claim(count);
+        const size_type last = first + count;
+        size_type n = first;
+        while (n < last) {
+            const size_type k = segment_index_of(n);
+            pointer seg = ensure_segment(k);
+            const size_type seg_end = laistl::min(last, segment_base(k) + segment_size(k));
+            laistl::uninitialized_fill_n(seg + (n - segment_base(k)), seg_end - n, value);
+            std::memset(constructed_flags(seg, k) + (n - segment_base(k)), 1, seg_end - n);
+            n = seg_end;
+        }
+        return first;
+    }
+
+    // 析构所有构造成功的元素，保留已分配的段
+    template <class T>
+    void concurrent_vector<T>::clear() {
+        const size_type n = size_.load(std::memory_order_relaxed);
+        for (size_type k = 0; segment_base(k) < n; ++k) {
+            pointer seg = segments_[k].load(std::memory_order_relaxed);
+            if (seg == nullptr) {
+                continue;   // 分配该段时抛出了异常
+            }
+            const size_type len = laistl::min(n - segment_base(k), segment_size(k));
+            unsigned char* flags = constructed_flags(seg, k);
+            if (!std::is_trivially_destructible<T>::value) {
+                for (size_type i = 0; i < len; ++i) {
+                    if (flags[i]) {
+                        data_allocator::destroy(seg + i);
+                    }
+                }
+            }
+            std::memset(flags, 0, len);
+        }
+        size_.store(0, std::memory_order_release);
+    }
+
+    // helper functions
+    template <class T>
+    void concurrent_vector<T>::init_segments() noexcept {
+        for (size_type k = 0; k < max_segments; ++k) {
+            segments_[k].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    // segment_index_of: 下标 n 所在的段号
+    template <class T>
+    typename concurrent_vector<T>::size_type
+    concurrent_vector<T>::segment_index_of(size_type n) noexcept {
+        size_type v = (n + first_segment_size) >> first_segment_log;
+        size_type k = 0;
+        while (v >>= 1) {
+            ++k;
+        }
+        return k;
+    }
+
+    template <class T>
+    typename concurrent_vector<T>::pointer
+    concurrent_vector<T>::element_at(size_type n) const noexcept {
+        const size_type k = segment_index_of(n);
+        return segments_[k].load(std::memory_order_acquire) + (n - segment_base(k));
+    }
+
+    // claim: 原子地占用 count 个连续下标，返回第一个；总数超过 max_size() 时抛出 length_error 且不占用
+    template <class T>
+    typename concurrent_vector<T>::size_type
+    concurrent_vector<T>::claim(size_type count) {
+        size_type first = size_.load(std::memory_order_relaxed);
+        do {
+            THROW_LENGTH_ERROR_IF(count > max_size() - first, "concurrent_vector<T>'s size too big");
+        } while (!size_.compare_exchange_weak(first, first + count, std::memory_order_acq_rel,
+                                              std::memory_order_relaxed));
+        return first;
+    }
+
+    // ensure_segment: 第 k 段不存在时分配并清零构造标记，多个线程竞争时只有一个分配结果被采用
+    template <class T>
+    typename concurrent_vector<T>::pointer
+    concurrent_vector<T>::ensure_segment(size_type k) {
+        THROW_LENGTH_ERROR_IF(k >= max_segments, "concurrent_vector<T> segment index out of range");
+        pointer seg = segments_[k].load(std::memory_order_acquire);
+        if (seg != nullptr) {
+            return seg;
+        }
+        pointer fresh = data_allocator::allocate(segment_alloc_size(k));
+        std::memset(constructed_flags(fresh, k), 0, segment_size(k));
+        if (segments_[k].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel)) {
+            return fresh;
+        }
+        data_allocator::deallocate(fresh, segment_alloc_size(k));
+        return seg;
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
+} /* namespace laistl */
+
+#endif /* _CONCURRENT_VECTOR_H */
@@ -6,6 +6,11 @@
 #include <new>
 #include "type_traits.h"
 #include "iterator.h"
+#include "util.h"
+
+#if MYSTL_HAS_CONSTEXPR20
+#include <memory>   // std::construct_at
+#endif
 
 #ifdef _MSC_VER 
 #pragma warning(push)
@@ -14,49 +19,71 @@
 
 namespace laistl {
     // 构造对象 
+    // 常量求值中不能使用定位 new，C++20 下改用 std::construct_at
     template <class Ty>
-    void construct(Ty* ptr) {
+    MYSTL_CONSTEXPR20 void construct(Ty* ptr) {
+    #if MYSTL_HAS_CONSTEXPR20
+        if (laistl::is_constant_evaluated()) {
+            std::construct_at(ptr);
+            return;
+        }
+    #endif
         ::new ((void*)ptr) Ty();
     }
 
     template <class Ty1, class Ty2>
-    void construct(Ty1* ptr, const Ty2& value) {
+    MYSTL_CONSTEXPR20 void construct(Ty1* ptr, const Ty2& value) {
+    #if MYSTL_HAS_CONSTEXPR20
+        if (laistl::is_constant_evaluated()) {
+            std::construct_at(ptr, value);
+            return;
+        }
+    #endif
         ::new((void*)ptr) Ty1(value);
     }
 
     template <class Ty1, class... Args>
-    void construct(Ty1* ptr, Args&&... value) {
+    MYSTL_CONSTEXPR20 void construct(Ty1* ptr, Args&&... args) {
+    #if MYSTL_HAS_CONSTEXPR20
+        if (laistl::is_constant_evaluated()) {
+            std::construct_at(ptr, laistl::forward<Args>(args)...);
+            return;
+        }
+    #endif
         ::new((void*)ptr) Ty1(laistl::forward<Args>(args)...);
     }
 
     // destroy 将对象析构 
     template <class Ty>
-    void destroy_one(Ty*, std::true_type) {} 
+    MYSTL_CONSTEXPR20 void destroy(Ty* pointer);
+
+    template <class Ty>
+    MYSTL_CONSTEXPR20 void destroy_one(Ty*, std::true_type) {} 
 
     template <class Ty>
-    void destroy_one(Ty* pointer, std::false_type) {
+    MYSTL_CONSTEXPR20 void destroy_one(Ty* pointer, std::false_type) {
         if (pointer != nullptr) {
             pointer->~Ty();
         }
     } 
  
     template <class ForwardIter>
-    void destroy_cat(ForwardIter, ForwardIter, std::true_type) {} 
+    MYSTL_CONSTEXPR20 void destroy_cat(ForwardIter, ForwardIter, std::true_type) {} 
     
     template <class ForwardIter>
-    void destroy_cat(ForwardIter first, ForwardIter last, std::false_type) {
+    MYSTL_CONSTEXPR20 void destroy_cat(ForwardIter first, ForwardIter last, std::false_type) {
         for (; first != last; ++first) {
             destroy(&*first);
         }
     }
 
     template <class Ty>
-    void destroy(Ty* pointer) {
+    MYSTL_CONSTEXPR20 void destroy(Ty* pointer) {
         destroy_one(pointer, std::is_trivially_destructible<Ty>{});
     }
 
     template <class ForwardIter>
-    void destroy(ForwardIter first, ForwardIter last) {
+    MYSTL_CONSTEXPR20 void destroy(ForwardIter first, ForwardIter last) {
         destroy_cat(first, last, std::is_trivially_destructible<
         typename iterator_traits<ForwardIter>::value_type>{});
     }
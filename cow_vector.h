@@ -0,0 +1,365 @@
+#ifndef _COW_VECTOR_H
+#define _COW_VECTOR_H
+
+// 写时复制的共享 vector：cow_vector，以及原子发布版本的 atomic_cow_vector
+// cow_vector 的缓冲区按引用计数共享，拷贝为 O(1)，只在第一次修改时复制出私有副本
+// atomic_cow_vector 用于多线程共享：写者整体替换版本，读者无锁地取得快照且不复制数据
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "util.h"
+#include "vector.h"
+
+namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
+    template <class T>
+    class atomic_cow_vector;
+
+    // 共享的缓冲区：引用计数和实际存放数据的 vector
+    template <class T>
+    struct cow_rep {
+        std::atomic<size_t> refs;
+        vector<T>           vec;
+
+        cow_rep() : refs(1), vec() {}
+        explicit cow_rep(const vector<T>& v) : refs(1), vec(v) {}
+        explicit cow_rep(vector<T>&& v) : refs(1), vec(laistl::move(v)) {}
+    };
+
+    // 模板类：cow_vector
+    // 一个 cow_vector 对象本身不是线程安全的；不同线程各自持有的 cow_vector 可以共享同一个缓冲区，
+    // 只读访问不会触发复制，修改操作先复制出私有副本，因此不影响其他持有者
+    template <class T>
+    class cow_vector {
+        friend class atomic_cow_vector<T>;
+
+    public:
+        typedef cow_rep<T>                                  rep_type;
+        typedef laistl::allocator<rep_type>                 rep_allocator;
+
+        typedef typename vector<T>::value_type              value_type;
+        typedef typename vector<T>::const_pointer           const_pointer;
+        typedef typename vector<T>::const_reference         const_reference;
+        typedef typename vector<T>::size_type               size_type;
+        typedef typename vector<T>::difference_type         difference_type;
+        typedef typename vector<T>::const_iterator          const_iterator;
+        typedef typename vector<T>::const_reverse_iterator  const_reverse_iterator;
+
+    private:
+        rep_type* rep_;     // 为空时表示空容器
+
+    public:
+        // 构造、复制、移动、析构函数
+        cow_vector() noexcept : rep_(nullptr) {}
+        explicit cow_vector(size_type n) : rep_(make_rep(vector<T>(n))) {}
+        cow_vector(size_type n, const value_type& value) : rep_(make_rep(vector<T>(n, value))) {}
+
+        template <class Iter, typename std::enable_if<
+            laistl::is_input_iterator<Iter>::value, int>::type = 0>
+        cow_vector(Iter first, Iter last) : rep_(make_rep(vector<T>(first, last))) {}
+
+        cow_vector(std::initializer_list<value_type> ilist) : rep_(make_rep(vector<T>(ilist))) {}
+
+        // 接管 vector 的缓冲区，不复制元素
+        explicit cow_vector(vector<T>&& v) : rep_(make_rep(laistl::move(v))) {}
+        explicit cow_vector(const vector<T>& v) : rep_(make_rep(v)) {}
+
+        cow_vector(const cow_vector& rhs) noexcept : rep_(rhs.rep_) { acquire(rep_); }
+        cow_vector(cow_vector&& rhs) noexcept : rep_(rhs.rep_) { rhs.rep_ = nullptr; }
+
+        cow_vector& operator=(const cow_vector& rhs) noexcept {
+            cow_vector(rhs).swap(*this);
+            return *this;
+        }
+
+        cow_vector& operator=(cow_vector&& rhs) noexcept {
+            cow_vector(laistl::move(rhs)).swap(*this);
+            return *this;
+        }
+
+        ~cow_vector() { release(rep_); }
+
+    public:
+        // 只读操作，不会触发复制
+        const_iterator          begin()   const noexcept { return rep_ ? rep_->vec.begin() : nullptr; }
+        const_iterator          end()     const noexcept { return rep_ ? rep_->vec.end() : nullptr; }
+        const_iterator          cbegin()  const noexcept { return begin(); }
+        const_iterator          cend()    const noexcept { return end(); }
+        const_reverse_iterator  rbegin()  const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator  rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+        bool        empty()     const noexcept { return size() == 0; }
+        size_type   size()      const noexcept { return rep_ ? rep_->vec.size() : 0; }
+        size_type   capacity()  const noexcept { return rep_ ? rep_->vec.capacity() : 0; }
+        const_pointer data()    const noexcept { return rep_ ? rep_->vec.data() : nullptr; }
+
+        const_reference operator[](size_type n) const {
+            MYSTL_CHECK_FAST(n < size());
+            return rep_->vec[n];
+        }
+
+        const_reference at(size_type n) const {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "cow_vector<T>::at() subscript out of range");
+            return rep_->vec[n];
+        }
+
+        const_reference front() const { MYSTL_CHECK_FAST(!empty()); return rep_->vec.front(); }
+        const_reference back()  const { MYSTL_CHECK_FAST(!empty()); return rep_->vec.back(); }
+
+        // 与其他持有者共享缓冲区的数目，空容器返回 0
+        size_type use_count() const noexcept {
+            return rep_ ? rep_->refs.load(std::memory_order_acquire) : 0;
+        }
+        bool unique() const noexcept { return use_count() <= 1; }
+
+        // 返回只读的 vector，空容器返回一个静态的空 vector
+        const vector<T>& get() const noexcept {
+            static const vector<T> empty_vec;
+            return rep_ ? rep_->vec : empty_vec;
+        }
+
+    public:
+        // 修改操作，缓冲区被共享时先复制出私有副本
+        // edit: 返回可修改的 vector，引用在下一次复制或共享之前有效
+        vector<T>& edit();
+
+        void set(size_type n, const value_type& value) {
+            MYSTL_CHECK_FAST(n < size());
+            edit()[n] = value;
+        }
+
+        template <class ...Args>
+        void emplace_back(Args&& ...args) { edit().emplace_back(laistl::forward<Args>(args)...); }
+
+        void push_back(const value_type& value) { edit().push_back(value); }
+        void push_back(value_type&& value) { edit().push_back(laistl::move(value)); }
+
+        void pop_back() {
+            MYSTL_CHECK_FAST(!empty());
+            edit().pop_back();
+        }
+
+        void resize(size_type n) { edit().resize(n); }
+        void resize(size_type n, const value_type& value) { edit().resize(n, value); }
+        void reserve(size_type n) { edit().reserve(n); }
+
+        // clear 直接放弃共享的缓冲区，不需要先复制
+        void clear() noexcept {
+            release(rep_);
+            rep_ = nullptr;
+        }
+
+        void swap(cow_vector& rhs) noexcept { laistl::swap(rep_, rhs.rep_); }
+
+    private:
+        // helper functions
+        template <class V>
+        static rep_type* make_rep(V&& v);
+        static void acquire(rep_type* r) noexcept {
+            if (r != nullptr) {
+                r->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        static void release(rep_type* r) noexcept;
+
+        explicit cow_vector(rep_type* r) noexcept : rep_(r) {}
+    };
+
+    /*****************************************************************************************/
+
+    // 分配并构造共享缓冲区，引用计数为 1
+    template <class T>
+    template <class V>
+    typename cow_vector<T>::rep_type* cow_vector<T>::make_rep(V&& v) {
+        rep_type* r = rep_allocator::allocate(1);
+        MYSTL_TRY {
+            rep_allocator::construct(r, laistl::forward<V>(v));
+        }
+        MYSTL_CATCH_ALL {
+            rep_allocator::deallocate(r, 1);
+            MYSTL_RETHROW;
+        }
+        return r;
+    }
+
+    // 减少引用计数，最后一个持有者负责销毁
+    template <class T>
+    void cow_vector<T>::release(rep_type* r) noexcept {
+        if (r != nullptr && r->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            rep_allocator::destroy(r);
+            rep_allocator::deallocate(r, 1);
+        }
+    }
+
+    // edit: 缓冲区被共享时复制一份私有副本再返回
+    template <class T>
+    vector<T>& cow_vector<T>::edit() {
+        if (rep_ == nullptr) {
+            rep_ = make_rep(vector<T>());
+        } else if (rep_->refs.load(std::memory_order_acquire) != 1) {
+            rep_type* r = make_rep(rep_->vec);
+            release(rep_);
+            rep_ = r;
+        }
+        return rep_->vec;
+    }
+
+    // 重载比较操作符
+    template <class T>
+    bool operator==(const cow_vector<T>& lhs, const cow_vector<T>& rhs) {
+        return lhs.data() == rhs.data() || lhs.get() == rhs.get();
+    }
+
+    template <class T>
+    bool operator!=(const cow_vector<T>& lhs, const cow_vector<T>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // 重载 swap
+    template <class T>
+    void swap(cow_vector<T>& lhs, cow_vector<T>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    /*****************************************************************************************/
+
+    // 模板类：atomic_cow_vector
+    // 保存当前发布的版本，load 无锁地返回共享当前缓冲区的 cow_vector 快照，store / exchange 原子地替换版本
+    // 每次发布都分配一个新的发布节点，节点持有缓冲区的一个引用，且只会被发布一次，因此不存在 ABA 问题
+    // 采用分离引用计数：节点指针和“借用计数”打包在同一个 64 位原子字中，
+    // 读者先增加借用计数使节点不会被释放，再取得缓冲区的引用，最后归还借用计数；
+    // 写者替换节点时把尚未归还的借用计数结算到旧节点的内部计数中
+    // 多个写者可以并发调用 store / exchange；要求用户态指针不超过 48 位（x86-64 / AArch64 的 Linux 均满足）
+    template <class T>
+    class atomic_cow_vector {
+    public:
+        typedef cow_vector<T>                       value_type;
+        typedef typename cow_vector<T>::rep_type    rep_type;
+
+    private:
+        // 发布节点，internal 为借用的结算值：写者加上借用计数，读者各减 1，归零时释放
+        struct node_type {
+            std::atomic<ptrdiff_t>  internal;
+            rep_type*               rep;
+        };
+        typedef laistl::allocator<node_type> node_allocator;
+
+        static constexpr int      count_shift = 48;
+        static constexpr uint64_t count_one = uint64_t(1) << count_shift;
+        static constexpr uint64_t ptr_mask = count_one - 1;
+
+        static_assert(sizeof(void*) == 8, "atomic_cow_vector requires 64-bit pointers");
+
+        alignas(cache_line_size) mutable std::atomic<uint64_t> word_;
+
+    public:
+        // 构造、析构函数
+        atomic_cow_vector() noexcept : word_(0) {}
+        explicit atomic_cow_vector(cow_vector<T> v) : word_(make_node(v)) {}
+
+        atomic_cow_vector(const atomic_cow_vector&) = delete;
+        atomic_cow_vector& operator=(const atomic_cow_vector&) = delete;
+
+        ~atomic_cow_vector() { settle(word_.load(std::memory_order_relaxed)); }
+
+    public:
+        // load: 返回当前版本的快照，不加锁、不复制元素
+        cow_vector<T> load() const noexcept;
+
+        // store / exchange: 发布新版本，旧版本在最后一个快照释放后销毁
+        void store(cow_vector<T> v) { settle(word_.exchange(make_node(v), std::memory_order_acq_rel)); }
+        cow_vector<T> exchange(cow_vector<T> v) {
+            const uint64_t old = word_.exchange(make_node(v), std::memory_order_acq_rel);
+            cow_vector<T> result = snapshot_of(ptr_of(old));
+            settle(old);
+            return result;
+        }
+
+    private:
+        // helper functions
+        static node_type* ptr_of(uint64_t w) noexcept {
+            return reinterpret_cast<node_type*>(static_cast<uintptr_t>(w & ptr_mask));
+        }
+
+        static cow_vector<T> snapshot_of(node_type* n) noexcept {
+            if (n == nullptr) {
+                return cow_vector<T>();
+            }
+            cow_vector<T>::acquire(n->rep);
+            return cow_vector<T>(n->rep);
+        }
+
+        // 取走 v 持有的缓冲区引用，放入新的发布节点，返回对应的原子字
+        static uint64_t make_node(cow_vector<T>& v);
+
+        // 旧节点被替换：结算借用计数并放弃原子字对节点的所有权
+        static void settle(uint64_t old) noexcept {
+            node_type* n = ptr_of(old);
+            if (n != nullptr) {
+                const ptrdiff_t borrowed = static_cast<ptrdiff_t>(old >> count_shift);
+                if (n->internal.fetch_add(borrowed, std::memory_order_acq_rel) + borrowed == 0) {
+                    free_node(n);
+                }
+            }
+        }
+
+        // 读者在节点被替换后归还借用
+        static void unborrow(node_type* n) noexcept {
+            if (n->internal.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                free_node(n);
+            }
+        }
+
+        static void free_node(node_type* n) noexcept {
+            cow_vector<T>::release(n->rep);
+            node_allocator::deallocate(n, 1);
+        }
+    };
+
+    // make_node
+    template <class T>
+    uint64_t atomic_cow_vector<T>::make_node(cow_vector<T>& v) {
+        if (v.rep_ == nullptr) {
+            return 0;
+        }
+        node_type* n = node_allocator::allocate(1);
+        ::new ((void*)&n->internal) std::atomic<ptrdiff_t>(0);
+        n->rep = v.rep_;
+        v.rep_ = nullptr;
+        const uint64_t w = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(n));
+        MYSTL_DEBUG((w & ~ptr_mask) == 0);
+        return w;
+    }
+
+    // load
+    template <class T>
+    cow_vector<T> atomic_cow_vector<T>::load() const noexcept {
+        // 借用：此后节点在我们归还之前不会被释放
+        uint64_t cur = word_.fetch_add(count_one, std::memory_order_acquire) + count_one;
+        node_type* n = ptr_of(cur);
+        cow_vector<T> result = snapshot_of(n);
+        // 归还借用：节点仍在发布时从原子字中减去（release，使写者结算时看到我们对节点的读取已完成），
+        // 已被替换时借用已结算到节点中
+        for (;;) {
+            if (ptr_of(cur) != n) {
+                if (n != nullptr) {
+                    unborrow(n);
+                }
+                break;
+            }
+            if (word_.compare_exchange_weak(cur, cur - count_one, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        return result;
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
+} /* namespace laistl */
+
+#endif /* _COW_VECTOR_H */
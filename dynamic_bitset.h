@@ -0,0 +1,457 @@
+#ifndef _DYNAMIC_BITSET_H
+#define _DYNAMIC_BITSET_H
+
+// 按位压缩的动态位集，代替被禁用的 vector<bool>
+// 位存放在 64 位字中，整体操作逐字进行，位集之间的与、或、异或、与非使用 SSE2 / AVX2 批量处理
+
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
+    // popcount64: 统计 64 位字中 1 的个数
+    inline size_t popcount64(uint64_t x) noexcept {
+    #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(x));
+    #elif defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<size_t>(__popcnt64(x));
+    #else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<size_t>((x * 0x0101010101010101ULL) >> 56);
+    #endif
+    }
+
+    // countr_zero64: 最低位 1 之前 0 的个数，x 不能为 0
+    inline size_t countr_zero64(uint64_t x) noexcept {
+    #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(x));
+    #elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long idx;
+        _BitScanForward64(&idx, x);
+        return static_cast<size_t>(idx);
+    #else
+        size_t n = 0;
+        while ((x & 1) == 0) {
+            x >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    // 位运算函数对象，提供标量版本和 SIMD 版本
+    struct bit_and_op {
+        static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a & b; }
+    #if defined(__AVX2__)
+        static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_and_si256(a, b); }
+    #elif defined(__SSE2__)
+        static __m128i apply(__m128i a, __m128i b) noexcept { return _mm_and_si128(a, b); }
+    #endif
+    };
+
+    struct bit_or_op {
+        static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a | b; }
+    #if defined(__AVX2__)
+        static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_or_si256(a, b); }
+    #elif defined(__SSE2__)
+        static __m128i apply(__m128i a, __m128i b) noexcept { return _mm_or_si128(a, b); }
+    #endif
+    };
+
+    struct bit_xor_op {
+        static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a ^ b; }
+    #if defined(__AVX2__)
+        static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_xor_si256(a, b); }
+    #elif defined(__SSE2__)
+        static __m128i apply(__m128i a, __m128i b) noexcept { return _mm_xor_si128(a, b); }
+    #endif
+    };
+
+    // a & ~b
+    struct bit_andnot_op {
+        static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a & ~b; }
+    #if defined(__AVX2__)
+        static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_andnot_si256(b, a); }
+    #elif defined(__SSE2__)
+        static __m128i apply(__m128i a, __m128i b) noexcept { return _mm_andnot_si128(b, a); }
+    #endif
+    };
+
+    // bitwise_words: dst[i] = Op(dst[i], src[i])，先按向量宽度处理，剩余部分逐字处理
+    template <class Op>
+    void bitwise_words(uint64_t* dst, const uint64_t* src, size_t n) noexcept {
+        size_t i = 0;
+    #if defined(__AVX2__)
+        for (; i + 4 <= n; i += 4) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), Op::apply(a, b));
+        }
+    #elif defined(__SSE2__)
+        for (; i + 2 <= n; i += 2) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), Op::apply(a, b));
+        }
+    #endif
+        for (; i < n; ++i) {
+            dst[i] = Op::apply(dst[i], src[i]);
+        }
+    }
+
+    // 类：dynamic_bitset
+    // 第 pos 位位于 words_[pos / 64] 的第 (pos % 64) 位；最后一个字中超出 size() 的位始终为 0
+    class dynamic_bitset {
+    public:
+        typedef uint64_t                        word_type;
+        typedef size_t                          size_type;
+        using word_allocator = laistl::allocator<word_type>;
+
+        static constexpr size_type bits_per_word = 64;
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        word_type*  words_;     // 存放位的字数组
+        size_type   nbits_;     // 位数
+        size_type   cap_;       // 已分配的字数
+
+    public:
+        // 构造、复制、移动、析构函数
+        dynamic_bitset() noexcept : words_(nullptr), nbits_(0), cap_(0) {}
+
+        explicit dynamic_bitset(size_type n, bool value = false)
+            : words_(nullptr), nbits_(0), cap_(0) {
+            resize(n, value);
+        }
+
+        dynamic_bitset(const dynamic_bitset& rhs) : words_(nullptr), nbits_(0), cap_(0) {
+            reallocate(rhs.num_words());
+            laistl::copy(rhs.words_, rhs.words_ + rhs.num_words(), words_);
+            nbits_ = rhs.nbits_;
+        }
+
+        dynamic_bitset(dynamic_bitset&& rhs) noexcept
+            : words_(rhs.words_), nbits_(rhs.nbits_), cap_(rhs.cap_) {
+            rhs.words_ = nullptr;
+            rhs.nbits_ = 0;
+            rhs.cap_ = 0;
+        }
+
+        dynamic_bitset& operator=(const dynamic_bitset& rhs) {
+            if (this != &rhs) {
+                dynamic_bitset tmp(rhs);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        dynamic_bitset& operator=(dynamic_bitset&& rhs) noexcept {
+            dynamic_bitset tmp(laistl::move(rhs));
+            swap(tmp);
+            return *this;
+        }
+
+        ~dynamic_bitset() { word_allocator::deallocate(words_, cap_); }
+
+    public:
+        // 容器操作
+        bool empty()            const noexcept { return nbits_ == 0; }
+        size_type size()        const noexcept { return nbits_; }
+        size_type num_words()   const noexcept { return words_for(nbits_); }
+        size_type capacity()    const noexcept { return cap_ * bits_per_word; }
+
+        word_type*       data()       noexcept { return words_; }
+        const word_type* data() const noexcept { return words_; }
+
+        void reserve(size_type n) {
+            if (words_for(n) > cap_) {
+                reallocate(words_for(n));
+            }
+        }
+
+        void resize(size_type n, bool value = false);
+        void push_back(bool value);
+        void clear() noexcept { nbits_ = 0; }
+
+        void swap(dynamic_bitset& rhs) noexcept {
+            laistl::swap(words_, rhs.words_);
+            laistl::swap(nbits_, rhs.nbits_);
+            laistl::swap(cap_, rhs.cap_);
+        }
+
+    public:
+        // 单个位操作
+        bool test(size_type pos) const {
+            MYSTL_CHECK_FAST(pos < nbits_);
+            return (words_[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+        }
+
+        bool operator[](size_type pos) const { return test(pos); }
+
+        dynamic_bitset& set(size_type pos, bool value = true) {
+            MYSTL_CHECK_FAST(pos < nbits_);
+            const word_type mask = word_type(1) << (pos % bits_per_word);
+            if (value) {
+                words_[pos / bits_per_word] |= mask;
+            } else {
+                words_[pos / bits_per_word] &= ~mask;
+            }
+            return *this;
+        }
+
+        dynamic_bitset& reset(size_type pos) { return set(pos, false); }
+
+        dynamic_bitset& flip(size_type pos) {
+            MYSTL_CHECK_FAST(pos < nbits_);
+            words_[pos / bits_per_word] ^= word_type(1) << (pos % bits_per_word);
+            return *this;
+        }
+
+        // 整体操作，逐字进行
+        dynamic_bitset& set() noexcept;
+        dynamic_bitset& reset() noexcept;
+        dynamic_bitset& flip() noexcept;
+
+        // 区间 [first, last) 操作，首尾两个字用掩码处理，中间整字处理
+        dynamic_bitset& set(size_type first, size_type last, bool value);
+        dynamic_bitset& flip(size_type first, size_type last);
+
+    public:
+        // 查询操作
+        size_type count() const noexcept;
+        bool any() const noexcept;
+        bool none() const noexcept { return !any(); }
+        bool all() const noexcept { return count() == nbits_; }
+
+        // 找到第一个 / pos 之后的下一个为 1 的位，找不到时返回 npos
+        size_type find_first() const noexcept { return find_from(0); }
+        size_type find_next(size_type pos) const noexcept {
+            return pos + 1 >= nbits_ ? npos : find_from(pos + 1);
+        }
+
+    public:
+        // 位集之间的批量操作，两者大小必须相同
+        dynamic_bitset& operator&=(const dynamic_bitset& rhs) { return apply<bit_and_op>(rhs); }
+        dynamic_bitset& operator|=(const dynamic_bitset& rhs) { return apply<bit_or_op>(rhs); }
+        dynamic_bitset& operator^=(const dynamic_bitset& rhs) { return apply<bit_xor_op>(rhs); }
+        // *this &= ~rhs
+        dynamic_bitset& and_not(const dynamic_bitset& rhs) { return apply<bit_andnot_op>(rhs); }
+
+        dynamic_bitset operator~() const {
+            dynamic_bitset tmp(*this);
+            tmp.flip();
+            return tmp;
+        }
+
+    private:
+        // helper functions
+        static size_type words_for(size_type n) noexcept { return (n + bits_per_word - 1) / bits_per_word; }
+        void trim() noexcept;
+        void reallocate(size_type new_cap);
+        size_type find_from(size_type pos) const noexcept;
+
+        template <class Op>
+        dynamic_bitset& apply(const dynamic_bitset& rhs) {
+            MYSTL_DEBUG(nbits_ == rhs.nbits_);
+            bitwise_words<Op>(words_, rhs.words_, num_words());
+            return *this;
+        }
+    };
+
+    // 改变位数，新增的位取 value
+    inline void dynamic_bitset::resize(size_type n, bool value) {
+        const size_type old_words = num_words();
+        const size_type new_words = words_for(n);
+        if (new_words > cap_) {
+            reallocate(laistl::max(new_words, cap_ + cap_ / 2));
+        }
+        if (n > nbits_) {
+            if (value) {
+                const size_type old_bits = nbits_;
+                nbits_ = n;
+                laistl::fill_n(words_ + old_words, new_words - old_words, ~word_type(0));
+                set(old_bits, n, true);
+            } else {
+                // 超出 size() 的位已为 0，只需把新增的整字清零
+                laistl::fill_n(words_ + old_words, new_words - old_words, word_type(0));
+                nbits_ = n;
+            }
+        } else {
+            nbits_ = n;
+        }
+        trim();
+    }
+
+    inline void dynamic_bitset::push_back(bool value) {
+        if (nbits_ == cap_ * bits_per_word) {
+            reallocate(cap_ == 0 ? 1 : cap_ * 2);
+        }
+        if (nbits_ % bits_per_word == 0) {
+            words_[nbits_ / bits_per_word] = 0;
+        }
+        ++nbits_;
+        set(nbits_ - 1, value);
+    }
+
+    inline dynamic_bitset& dynamic_bitset::set() noexcept {
+        laistl::fill_n(words_, num_words(), ~word_type(0));
+        trim();
+        return *this;
+    }
+
+    inline dynamic_bitset& dynamic_bitset::reset() noexcept {
+        laistl::fill_n(words_, num_words(), word_type(0));
+        return *this;
+    }
+
+    inline dynamic_bitset& dynamic_bitset::flip() noexcept {
+        for (size_type i = 0; i < num_words(); ++i) {
+            words_[i] = ~words_[i];
+        }
+        trim();
+        return *this;
+    }
+
+    inline dynamic_bitset& dynamic_bitset::set(size_type first, size_type last, bool value) {
+        MYSTL_DEBUG(first <= last && last <= nbits_);
+        if (first == last) {
+            return *this;
+        }
+        const size_type fw = first / bits_per_word;
+        const size_type lw = (last - 1) / bits_per_word;
+        const word_type head = ~word_type(0) << (first % bits_per_word);
+        const word_type tail = ~word_type(0) >> (bits_per_word - 1 - (last - 1) % bits_per_word);
+        if (fw == lw) {
+            const word_type mask = head & tail;
+            words_[fw] = value ? (words_[fw] | mask) : (words_[fw] & ~mask);
+            return *this;
+        }
+        words_[fw] = value ? (words_[fw] | head) : (words_[fw] & ~head);
+        laistl::fill_n(words_ + fw + 1, lw - fw - 1, value ? ~word_type(0) : word_type(0));
+        words_[lw] = value ? (words_[lw] | tail) : (words_[lw] & ~tail);
+        return *this;
+    }
+
+    inline dynamic_bitset& dynamic_bitset::flip(size_type first, size_type last) {
+        MYSTL_DEBUG(first <= last && last <= nbits_);
+        if (first == last) {
+            return *this;
+        }
+        const size_type fw = first / bits_per_word;
+        const size_type lw = (last - 1) / bits_per_word;
+        const word_type head = ~word_type(0) << (first % bits_per_word);
+        const word_type tail = ~word_type(0) >> (bits_per_word - 1 - (last - 1) % bits_per_word);
+        if (fw == lw) {
+            words_[fw] ^= head & tail;
+            return *this;
+        }
+        words_[fw] ^= head;
+        for (size_type i = fw + 1; i < lw; ++i) {
+            words_[i] = ~words_[i];
+        }
+        words_[lw] ^= tail;
+        return *this;
+    }
+
+    inline dynamic_bitset::size_type dynamic_bitset::count() const noexcept {
+        size_type n = 0;
+        for (size_type i = 0; i < num_words(); ++i) {
+            n += popcount64(words_[i]);
+        }
+        return n;
+    }
+
+    inline bool dynamic_bitset::any() const noexcept {
+        for (size_type i = 0; i < num_words(); ++i) {
+            if (words_[i] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // trim: 清除最后一个字中超出 size() 的位
+    inline void dynamic_bitset::trim() noexcept {
+        const size_type extra = nbits_ % bits_per_word;
+        if (extra != 0) {
+            words_[nbits_ / bits_per_word] &= ~(~word_type(0) << extra);
+        }
+    }
+
+    inline void dynamic_bitset::reallocate(size_type new_cap) {
+        word_type* new_words = word_allocator::allocate(new_cap);
+        const size_type n = laistl::min(num_words(), new_cap);
+        laistl::copy(words_, words_ + n, new_words);
+        word_allocator::deallocate(words_, cap_);
+        words_ = new_words;
+        cap_ = new_cap;
+    }
+
+    // find_from: 从 pos 开始查找，先屏蔽首字中 pos 之前的位，再逐字用 countr_zero64 定位
+    inline dynamic_bitset::size_type dynamic_bitset::find_from(size_type pos) const noexcept {
+        if (pos >= nbits_) {
+            return npos;
+        }
+        size_type w = pos / bits_per_word;
+        word_type word = words_[w] & (~word_type(0) << (pos % bits_per_word));
+        const size_type nw = num_words();
+        while (word == 0) {
+            if (++w == nw) {
+                return npos;
+            }
+            word = words_[w];
+        }
+        return w * bits_per_word + countr_zero64(word);
+    }
+
+    // 重载比较操作符
+    inline bool operator==(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+        return lhs.size() == rhs.size() &&
+               laistl::equal(lhs.data(), lhs.data() + lhs.num_words(), rhs.data());
+    }
+
+    inline bool operator!=(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+        return !(lhs == rhs);
+    }
+
+    inline dynamic_bitset operator&(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+        dynamic_bitset tmp(lhs);
+        tmp &= rhs;
+        return tmp;
+    }
+
+    inline dynamic_bitset operator|(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+        dynamic_bitset tmp(lhs);
+        tmp |= rhs;
+        return tmp;
+    }
+
+    inline dynamic_bitset operator^(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+        dynamic_bitset tmp(lhs);
+        tmp ^= rhs;
+        return tmp;
+    }
+
+    // 重载 swap
+    inline void swap(dynamic_bitset& lhs, dynamic_bitset& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
+} /* namespace laistl */
+
+#endif /* _DYNAMIC_BITSET_H */
@@ -3,20 +3,148 @@
 
 #include <stdexcept>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+// 加固级别，在包含任何 laistl 头文件之前定义 MYSTL_HARDENING 即可按翻译单元选择：
+//   MYSTL_HARDENING_NONE   不做任何检查
+//   MYSTL_HARDENING_FAST   只做廉价的边界检查：operator[]、front/back、pop_back 等，失败时进入冷路径终止程序
+//   MYSTL_HARDENING_DEBUG  在 FAST 的基础上检查迭代器是否属于容器、区间是否合法等
+// 未定义时沿用 assert 的约定：定义了 NDEBUG 为 NONE，否则为 DEBUG
+// 含有检查的容器位于以级别命名的内联命名空间 laistl::hardening_N 中，级别不同的翻译单元实例化出的
+// 是不同的符号，可以链接进同一个程序而不违反 ODR；但不能在这些翻译单元之间传递容器对象
+#define MYSTL_HARDENING_NONE  0
+#define MYSTL_HARDENING_FAST  1
+#define MYSTL_HARDENING_DEBUG 2
+
+#ifndef MYSTL_HARDENING
+    #ifdef NDEBUG
+        #define MYSTL_HARDENING MYSTL_HARDENING_NONE
+    #else
+        #define MYSTL_HARDENING MYSTL_HARDENING_DEBUG
+    #endif
+#endif
+
+// 加固级别对应的内联命名空间名，MYSTL_HARDENING 须展开为 0、1 或 2
+#define MYSTL_HARDENING_NAMESPACE_NAME_(level) hardening_##level
+#define MYSTL_HARDENING_NAMESPACE_NAME(level) MYSTL_HARDENING_NAMESPACE_NAME_(level)
+#define MYSTL_HARDENING_NAMESPACE MYSTL_HARDENING_NAMESPACE_NAME(MYSTL_HARDENING)
+
+// 是否启用了异常，-fno-exceptions 编译时为 0
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+    #define MYSTL_HAS_EXCEPTIONS 1
+#else
+    #define MYSTL_HAS_EXCEPTIONS 0
+#endif
+
+// 清理代码使用的 try / catch (...) / throw;，禁用异常时 catch 块成为不可达的分支
+#if MYSTL_HAS_EXCEPTIONS
+    #define MYSTL_TRY        try
+    #define MYSTL_CATCH_ALL  catch (...)
+    #define MYSTL_RETHROW    throw
+#else
+    #define MYSTL_TRY        if (true)
+    #define MYSTL_CATCH_ALL  else
+    #define MYSTL_RETHROW    ((void)0)
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define MYSTL_LIKELY(expr)   __builtin_expect(!!(expr), 1)
+    #define MYSTL_UNLIKELY(expr) __builtin_expect(!!(expr), 0)
+    #define MYSTL_COLD           __attribute__((cold, noinline))
+#else
+    #define MYSTL_LIKELY(expr)   (expr)
+    #define MYSTL_UNLIKELY(expr) (expr)
+    #define MYSTL_COLD
+#endif
 
 namespace laistl {
-    #define MYSTL_DEBUG(expr) assert(expr)
+    inline namespace MYSTL_HARDENING_NAMESPACE {}
+
+    // 检查失败时调用，放在冷路径上，热循环中只留下一次比较和一个很少走到的跳转
+    [[noreturn]] MYSTL_COLD inline void hardening_trap(const char* expr, const char* file, int line) {
+        std::fprintf(stderr, "%s:%d: laistl hardening check failed: %s\n", file, line, expr);
+        std::abort();
+    }
+
+    #define MYSTL_HARDENING_CHECK(expr) \
+        (MYSTL_LIKELY(expr) ? (void)0 : laistl::hardening_trap(#expr, __FILE__, __LINE__))
+
+    // MYSTL_CHECK_FAST: FAST 及以上级别生效的廉价检查
+    #if MYSTL_HARDENING >= MYSTL_HARDENING_FAST
+        #define MYSTL_CHECK_FAST(expr) MYSTL_HARDENING_CHECK(expr)
+    #else
+        #define MYSTL_CHECK_FAST(expr) ((void)0)
+    #endif
+
+    // MYSTL_DEBUG: 只在 DEBUG 级别生效的检查
+    #if MYSTL_HARDENING >= MYSTL_HARDENING_DEBUG
+        #define MYSTL_DEBUG(expr) MYSTL_HARDENING_CHECK(expr)
+    #else
+        #define MYSTL_DEBUG(expr) ((void)0)
+    #endif
+
+    // 错误处理
+    // THROW_*_IF 检测到错误时调用 raise_error：若用 set_error_handler 安装了处理函数则先调用它，
+    // 处理函数可以终止程序、抛出自定义异常或长跳转；返回后，启用异常时抛出对应的标准异常，否则终止程序
+    // 需要在失败时得到状态码而不是终止的场合，使用 try_reserve / try_push_back 等 try_ 版本
+    enum class error_code {
+        length_error,
+        out_of_range,
+        runtime_error
+    };
+
+    typedef void (*error_handler)(error_code code, const char* what);
+
+    inline error_handler& error_handler_slot() noexcept {
+        static error_handler handler = nullptr;
+        return handler;
+    }
+
+    // 安装错误处理函数，返回原先的处理函数，传入 nullptr 恢复默认行为
+    inline error_handler set_error_handler(error_handler handler) noexcept {
+        error_handler old = error_handler_slot();
+        error_handler_slot() = handler;
+        return old;
+    }
+
+    // 直接终止
+    inline void abort_error_handler(error_code, const char*) {
+        std::abort();
+    }
+
+    // 输出错误信息后终止，禁用异常时的默认行为
+    inline void log_and_abort_error_handler(error_code, const char* what) {
+        std::fprintf(stderr, "laistl error: %s\n", what);
+        std::abort();
+    }
+
+    [[noreturn]] MYSTL_COLD inline void raise_error(error_code code, const char* what) {
+        if (error_handler handler = error_handler_slot()) {
+            handler(code, what);
+        }
+    #if MYSTL_HAS_EXCEPTIONS
+        switch (code) {
+        case error_code::length_error: throw std::length_error(what);
+        case error_code::out_of_range: throw std::out_of_range(what);
+        default:                       throw std::runtime_error(what);
+        }
+    #else
+        log_and_abort_error_handler(code, what);
+        std::abort();
+    #endif
+    }
 
     #define THROW_LENGTH_ERROR_IF(expr, what) { \
-        if ((expr)) throw std::length_error(what)\
+        if (MYSTL_UNLIKELY(expr)) laistl::raise_error(laistl::error_code::length_error, what); \
     }
 
     #define THROW_OUT_OF_RANGE_IF(expr, what) { \
-        if ((expr)) throw std::out_of_range(what)\
+        if (MYSTL_UNLIKELY(expr)) laistl::raise_error(laistl::error_code::out_of_range, what); \
     }
 
     #define THROW_RUNTIME_ERROR_IF(expr, what) { \
-        if ((expr)) throw std::runtime_error(what)\
+        if (MYSTL_UNLIKELY(expr)) laistl::raise_error(laistl::error_code::runtime_error, what); \
     }
 
 } /* namespace laistl */
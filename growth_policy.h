@@ -0,0 +1,78 @@
+#ifndef _GROWTH_POLICY_H
+#define _GROWTH_POLICY_H
+
+// vector 的容量增长策略
+// 策略是只含静态成员函数的类型，作为 vector 的第二个模板参数：
+//   initial(n, elem_size)              构造时容纳 n 个元素所分配的容量，n 为 0 时返回 0 表示不分配
+//   grow(cap, need, max_n, elem_size)  已有容量 cap 不足以容纳 need 个元素时的新容量，需满足 need <= 结果 <= max_n
+// 在常量求值中使用 vector 时，策略的函数也须能在常量求值中调用（C++20 下用 MYSTL_CONSTEXPR20 标注）
+
+#include <cstddef>
+
+#include "algobase.h"
+
+namespace laistl {
+    // geometric_growth: 容量按 Num / Den 倍增长，不小于 Min 个元素
+    // 默认 1.5 倍、最少 16 个元素，与原先的行为一致
+    template <size_t Num = 3, size_t Den = 2, size_t Min = 16>
+    struct geometric_growth {
+        static_assert(Den != 0 && Num > Den, "growth factor must be greater than 1");
+
+        static MYSTL_CONSTEXPR20 size_t initial(size_t n, size_t) noexcept {
+            return laistl::max(n, Min);
+        }
+
+        static MYSTL_CONSTEXPR20 size_t grow(size_t cap, size_t need, size_t max_n, size_t) noexcept {
+            const size_t extra = cap / Den * (Num - Den) + cap % Den * (Num - Den) / Den;
+            const size_t next = extra > max_n - cap ? max_n : cap + extra;
+            return laistl::max(laistl::max(next, need), laistl::min(Min, max_n));
+        }
+    };
+
+    // exact_fit_growth: 构造时恰好分配所需容量，没有最小容量；增长时按 1.5 倍
+    // 适合大量只构造一次的小 vector
+    struct exact_fit_growth {
+        static MYSTL_CONSTEXPR20 size_t initial(size_t n, size_t) noexcept {
+            return n;
+        }
+
+        static MYSTL_CONSTEXPR20 size_t grow(size_t cap, size_t need, size_t max_n, size_t) noexcept {
+            const size_t next = cap / 2 > max_n - cap ? max_n : cap + cap / 2;
+            return laistl::max(next, need);
+        }
+    };
+
+    // page_rounded_growth: 在 Base 策略的基础上，缓冲区达到一页后把字节数向上取整到页大小的整数倍，
+    // 使大缓冲区的容量用满分配器按页取得的内存，减少大 vector 的重新分配次数
+    template <class Base = geometric_growth<>, size_t PageSize = 4096>
+    struct page_rounded_growth {
+        static_assert((PageSize & (PageSize - 1)) == 0, "page size must be a power of 2");
+
+        static MYSTL_CONSTEXPR20 size_t initial(size_t n, size_t elem_size) noexcept {
+            return n == 0 ? Base::initial(0, elem_size) : round(Base::initial(n, elem_size), n, elem_size);
+        }
+
+        static MYSTL_CONSTEXPR20 size_t grow(size_t cap, size_t need, size_t max_n, size_t elem_size) noexcept {
+            const size_t next = Base::grow(cap, need, max_n, elem_size);
+            return laistl::min(round(next, need, elem_size), max_n);
+        }
+
+    private:
+        static MYSTL_CONSTEXPR20 size_t round(size_t n, size_t need, size_t elem_size) noexcept {
+            if (n > static_cast<size_t>(-1) / elem_size - PageSize) {
+                return n;
+            }
+            const size_t bytes = n * elem_size;
+            if (bytes < PageSize) {
+                return n;
+            }
+            const size_t rounded = (bytes + PageSize - 1) & ~(PageSize - 1);
+            return laistl::max(rounded / elem_size, need);
+        }
+    };
+
+    typedef geometric_growth<> default_growth;
+
+} /* namespace laistl */
+
+#endif /* _GROWTH_POLICY_H */
@@ -2,6 +2,7 @@
 #define _ITERATOR_H
 
 #include <cstddef>
+#include <utility>
 #include "type_traits.h"
 
 namespace laistl {
@@ -12,6 +13,7 @@ namespace laistl {
     struct forward_iterator_tag : public input_iterator_tag {};                 // 向前迭代器
     struct bidirectional_iterator_tag : public forward_iterator_tag {};         // 双向迭代器
     struct random_access_iterator_tag : public bidirectional_iterator_tag {};   // 随机访问迭代器
+    struct contiguous_iterator_tag : public random_access_iterator_tag {};      // 连续存储迭代器
     
     // iterator 模板
     template <class Category, class T, class Distance = ptrdiff_t,
@@ -40,11 +42,11 @@ namespace laistl {
 
     template <class Iterator>
     struct iterator_traits_impl<Iterator, true> {
-        using iterator_category = Iterator::iterator_category;
-        using value_type = Iterator::value_type;
-        using pointer = Iterator::pointer;
-        using reference = Iterator::reference;
-        using difference_type = Iterator::difference_type;
+        using iterator_category = typename Iterator::iterator_category;
+        using value_type = typename Iterator::value_type;
+        using pointer = typename Iterator::pointer;
+        using reference = typename Iterator::reference;
+        using difference_type = typename Iterator::difference_type;
     };
 
     template <class Iterator, bool>
@@ -104,6 +106,12 @@ namespace laistl {
     template <class Iter>
     struct is_random_access_iterator : public has_iterator_cat_of<Iter, random_access_iterator_tag> {};
 
+    // 原生指针，以及 iterator_category 为 contiguous_iterator_tag 的迭代器
+    template <class Iter>
+    struct is_contiguous_iterator 
+        : public m_bool_constant<std::is_pointer<Iter>::value ||
+            has_iterator_cat_of<Iter, contiguous_iterator_tag>::value> {};
+
     template <class Iterator>
     struct is_iterator 
         : public m_bool_constant<is_input_iterator<Iterator>::value ||
@@ -111,9 +119,9 @@ namespace laistl {
 
     // 萃取某个迭代器的 category 
     template <class Iterator>
-    typename iterator_traits<Iterator>::iterator_category
+    MYSTL_CONSTEXPR20 typename iterator_traits<Iterator>::iterator_category
     iterator_category(const Iterator&) {
-        using Category = iterator_traits<Iterator>::iterator_category;
+        using Category = typename iterator_traits<Iterator>::iterator_category;
         return Category();
     }
 
@@ -127,14 +135,14 @@ namespace laistl {
     // 萃取某个迭代器的 value_type 
     template <class Iterator>
     typename iterator_traits<Iterator>::value_type*
-    distance_type(const Iterator&) {
+    value_type(const Iterator&) {
         return static_cast<typename iterator_traits<Iterator>::value_type*>(0);
     }
 
     // 计算迭代器的间距
     // distance 的 input_iterator_tag 的版本 
     template <class InputIterator>
-    typename iterator_traits<InputIterator>::difference_type
+    MYSTL_CONSTEXPR20 typename iterator_traits<InputIterator>::difference_type
     distance_dispatch(InputIterator first, InputIterator last, input_iterator_tag) {
         typename iterator_traits<InputIterator>::difference_type n = 0;
         while (first != last) {
@@ -146,14 +154,13 @@ namespace laistl {
 
     // distance 的 random_access_iterator_tag 的版本 
     template <class RandomIter>
-    typename iterator_traits<RandomIter>::difference_type
+    MYSTL_CONSTEXPR20 typename iterator_traits<RandomIter>::difference_type
     distance_dispatch(RandomIter first, RandomIter last, random_access_iterator_tag) {
-        typename iterator_traits<InputIterator>::difference_type n = 0;
         return last - first;
     }
 
     template <class InputIterator>
-    typename iterator_traits<InputIterator>::difference_type
+    MYSTL_CONSTEXPR20 typename iterator_traits<InputIterator>::difference_type
     distance(InputIterator first, InputIterator last) {
         return distance_dispatch(first, last, iterator_category(first));
     }
@@ -161,13 +168,13 @@ namespace laistl {
     // 让迭代器前进 n 个距离 
     // advance 的 input_iterator_tag 的版本
     template <class InputIterator, class Distance>
-    void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag) {
+    MYSTL_CONSTEXPR20 void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag) {
         while (n--) ++i;
     }
 
     // advance 的 bidirectional_iterator_tag 的版本
     template <class BidirectionalIter, class Distance>
-    void advance_dispatch(BidirectionalIter& i, Distance n, bidirectional_iterator_tag) {
+    MYSTL_CONSTEXPR20 void advance_dispatch(BidirectionalIter& i, Distance n, bidirectional_iterator_tag) {
         if (n >= 0) {
             while (n--) ++i;
         } else {
@@ -177,15 +184,51 @@ namespace laistl {
  
     // advance 的 random_access_iterator_tag 的版本
     template <class RandomIter, class Distance>
-    void advance_dispatch(RandomIter& i, Distance n, random_access_iterator_tag) {
+    MYSTL_CONSTEXPR20 void advance_dispatch(RandomIter& i, Distance n, random_access_iterator_tag) {
         i += n;
     }
 
     template <class InputIterator, class Distance>
-    void advance(InputIterator& i, Distance n) {
+    MYSTL_CONSTEXPR20 void advance(InputIterator& i, Distance n) {
         advance_dispatch(i, n, iterator_category(i));
     }
 
+    // 包装后不再按地址顺序连续的迭代器（反向、移动）把 contiguous_iterator_tag 降为 random_access_iterator_tag
+    template <class Category>
+    struct non_contiguous_category {
+        using type = typename std::conditional<std::is_same<Category, contiguous_iterator_tag>::value,
+            random_access_iterator_tag, Category>::type;
+    };
+
+    // 迭代器解包: 把包装在连续存储上的迭代器还原成原生指针，使算法可以直接使用指针上的批量版本
+    //   iter_unwrapper<Iter>::type       解包后的类型，不能解包时为 Iter 本身
+    //   unwrap(i)                        解包
+    //   rewrap(orig, u)                  把解包后的结果 u 还原成与 orig 同类型的迭代器
+    // 连续存储的类迭代器通过 iterator_category 声明为 contiguous_iterator_tag，其 operator-> 在尾后位置也须有效
+    template <class Iter, bool = is_contiguous_iterator<Iter>::value && !std::is_pointer<Iter>::value>
+    struct iter_unwrapper {
+        using type = Iter;
+        static MYSTL_CONSTEXPR20 type unwrap(Iter i) { return i; }
+        static MYSTL_CONSTEXPR20 Iter rewrap(Iter, type u) { return u; }
+    };
+
+    template <class Iter>
+    struct iter_unwrapper<Iter, true> {
+        using type = decltype(std::declval<Iter&>().operator->());
+        static MYSTL_CONSTEXPR20 type unwrap(Iter i) { return i.operator->(); }
+        static MYSTL_CONSTEXPR20 Iter rewrap(Iter orig, type u) { return orig + (u - unwrap(orig)); }
+    };
+
+    template <class Iter>
+    MYSTL_CONSTEXPR20 typename iter_unwrapper<Iter>::type unwrap_iter(Iter i) {
+        return iter_unwrapper<Iter>::unwrap(i);
+    }
+
+    template <class Iter>
+    MYSTL_CONSTEXPR20 Iter rewrap_iter(Iter orig, typename iter_unwrapper<Iter>::type u) {
+        return iter_unwrapper<Iter>::rewrap(orig, u);
+    }
+
     // 模板类： reverse_iterator, 反向迭代器，使前进为后退， 后退为前进
     template <class Iterator>
     class reverse_iterator {
@@ -193,107 +236,245 @@ namespace laistl {
         Iterator current;
     public:
         // 反向迭代器的5种相应类别 
-        using iterator_category = iterator_traits<Iterator>::iterator_category;
-        using value_type = iterator_traits<Iterator>::value_type;
-        using difference_type = iterator_traits<Iterator>::difference_type;
-        using pointer = iterator_traits<Iterator>::pointer;
-        using reference = iterator_traits<Iterator>::reference;
+        using iterator_category = typename non_contiguous_category<
+            typename iterator_traits<Iterator>::iterator_category>::type;
+        using value_type = typename iterator_traits<Iterator>::value_type;
+        using difference_type = typename iterator_traits<Iterator>::difference_type;
+        using pointer = typename iterator_traits<Iterator>::pointer;
+        using reference = typename iterator_traits<Iterator>::reference;
         
         using iterator_type = Iterator;
         using self = reverse_iterator<Iterator>;
 
     public:
         // 构造函数 
-        reverse_iterator() {}
-        explicit reverse_iterator(iterator_type i) : current(i) {}
-        reverse_iterator(const self& rhs) : current(rhs.current) {}
+        MYSTL_CONSTEXPR20 reverse_iterator() {}
+        MYSTL_CONSTEXPR20 explicit reverse_iterator(iterator_type i) : current(i) {}
+        MYSTL_CONSTEXPR20 reverse_iterator(const self& rhs) : current(rhs.current) {}
     public:
         // 取出对应的正向迭代器 
-        iterator_type base() const { return current; }
+        MYSTL_CONSTEXPR20 iterator_type base() const { return current; }
         // 重载操作符 ( 对应正向迭代器的前一个位置 ) 
-        reference operator*() const {
+        MYSTL_CONSTEXPR20 reference operator*() const {
             auto tmp = current;
             return *--tmp;
         }
-        pointer operator->() const { return &(operator*()); }
+        MYSTL_CONSTEXPR20 pointer operator->() const { return &(operator*()); }
         // 前进 ++, 变为后退 --
-        self& operator++() {
+        MYSTL_CONSTEXPR20 self& operator++() {
             --current;
             return *this;
         }
-        self operator++(int) {
+        MYSTL_CONSTEXPR20 self operator++(int) {
             self tmp = *this;
             --current;
             return tmp;
         }
         // 后退 --, 变为前进 ++
-        self& operator--() {
+        MYSTL_CONSTEXPR20 self& operator--() {
             ++current;
             return *this;
         }
         
-        self operator--(int) {
+        MYSTL_CONSTEXPR20 self operator--(int) {
             self tmp = *this;
             ++current;
             return tmp;
         }
 
-        self operator+=(difference_type n) {
+        MYSTL_CONSTEXPR20 self operator+=(difference_type n) {
             current -= n;
             return *this;
         }
 
-        self operator+(difference_type n) const { return self(current - n); }
+        MYSTL_CONSTEXPR20 self operator+(difference_type n) const { return self(current - n); }
 
-        self operator-=(difference_type n) {
+        MYSTL_CONSTEXPR20 self operator-=(difference_type n) {
             current += n;
             return *this;
         }
 
-        self operator-(difference_type n) const { return self(current + n); }
+        MYSTL_CONSTEXPR20 self operator-(difference_type n) const { return self(current + n); }
 
-        reference operator[](difference_type n) const { return *(*this + n); }
+        MYSTL_CONSTEXPR20 reference operator[](difference_type n) const { return *(*this + n); }
 
     };
 
     // 重载 operator-
     template <class Iterator>
-    typename reverse_iterator<Iterator>::difference_type 
+    MYSTL_CONSTEXPR20 typename reverse_iterator<Iterator>::difference_type 
     operator-(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) { 
         return rhs.base() - lhs.base();
     }
 
     // 重载比较操作符
     template <class Iterator>
-    bool operator==(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+    MYSTL_CONSTEXPR20 bool operator==(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+        return lhs.base() == rhs.base();
+    }
+
+    template <class Iterator>
+    MYSTL_CONSTEXPR20 bool operator<(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+        return lhs.base() < rhs.base();
+    }
+
+    template <class Iterator>
+    MYSTL_CONSTEXPR20 bool operator!=(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <class Iterator>
+    MYSTL_CONSTEXPR20 bool operator>(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+        return rhs < lhs;
+    }
+
+    template <class Iterator>
+    MYSTL_CONSTEXPR20 bool operator<=(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <class Iterator>
+    MYSTL_CONSTEXPR20 bool operator>=(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+        return !(lhs < rhs);
+    }
+
+    // reverse_iterator 解包为底层解包后的 reverse_iterator，如 reverse_iterator<T*>
+    template <class Iterator>
+    struct iter_unwrapper<reverse_iterator<Iterator>, false> {
+        using type = reverse_iterator<typename iter_unwrapper<Iterator>::type>;
+        static MYSTL_CONSTEXPR20 type unwrap(reverse_iterator<Iterator> i) {
+            return type(iter_unwrapper<Iterator>::unwrap(i.base()));
+        }
+        static MYSTL_CONSTEXPR20 reverse_iterator<Iterator> rewrap(reverse_iterator<Iterator> orig, type u) {
+            return reverse_iterator<Iterator>(iter_unwrapper<Iterator>::rewrap(orig.base(), u.base()));
+        }
+    };
+
+    // 模板类： move_iterator, 移动迭代器，解引用得到右值引用，通过它复制区间时元素被移动
+    template <class Iterator>
+    class move_iterator {
+    private:
+        Iterator current;
+        using base_reference = decltype(*std::declval<Iterator&>());
+    public:
+        using iterator_category = typename non_contiguous_category<
+            typename iterator_traits<Iterator>::iterator_category>::type;
+        using value_type = typename iterator_traits<Iterator>::value_type;
+        using difference_type = typename iterator_traits<Iterator>::difference_type;
+        using pointer = Iterator;
+        using reference = typename std::conditional<std::is_reference<base_reference>::value,
+            typename std::remove_reference<base_reference>::type&&, base_reference>::type;
+
+        using iterator_type = Iterator;
+        using self = move_iterator<Iterator>;
+
+    public:
+        // 构造函数 
+        MYSTL_CONSTEXPR20 move_iterator() : current() {}
+        MYSTL_CONSTEXPR20 explicit move_iterator(iterator_type i) : current(i) {}
+        template <class U>
+        MYSTL_CONSTEXPR20 move_iterator(const move_iterator<U>& rhs) : current(rhs.base()) {}
+    public:
+        MYSTL_CONSTEXPR20 iterator_type base() const { return current; }
+        MYSTL_CONSTEXPR20 reference operator*() const { return static_cast<reference>(*current); }
+        MYSTL_CONSTEXPR20 pointer operator->() const { return current; }
+
+        MYSTL_CONSTEXPR20 self& operator++() {
+            ++current;
+            return *this;
+        }
+        MYSTL_CONSTEXPR20 self operator++(int) {
+            self tmp = *this;
+            ++current;
+            return tmp;
+        }
+        MYSTL_CONSTEXPR20 self& operator--() {
+            --current;
+            return *this;
+        }
+        MYSTL_CONSTEXPR20 self operator--(int) {
+            self tmp = *this;
+            --current;
+            return tmp;
+        }
+
+        MYSTL_CONSTEXPR20 self& operator+=(difference_type n) {
+            current += n;
+            return *this;
+        }
+
+        MYSTL_CONSTEXPR20 self operator+(difference_type n) const { return self(current + n); }
+
+        MYSTL_CONSTEXPR20 self& operator-=(difference_type n) {
+            current -= n;
+            return *this;
+        }
+
+        MYSTL_CONSTEXPR20 self operator-(difference_type n) const { return self(current - n); }
+
+        MYSTL_CONSTEXPR20 reference operator[](difference_type n) const { return static_cast<reference>(current[n]); }
+    };
+
+    template <class Iterator>
+    MYSTL_CONSTEXPR20 typename move_iterator<Iterator>::difference_type
+    operator-(const move_iterator<Iterator>& lhs, const move_iterator<Iterator>& rhs) {
+        return lhs.base() - rhs.base();
+    }
+
+    template <class Iterator>
+    MYSTL_CONSTEXPR20 move_iterator<Iterator>
+    operator+(typename move_iterator<Iterator>::difference_type n, const move_iterator<Iterator>& it) {
+        return it + n;
+    }
+
+    template <class Iterator>
+    MYSTL_CONSTEXPR20 bool operator==(const move_iterator<Iterator>& lhs, const move_iterator<Iterator>& rhs) {
         return lhs.base() == rhs.base();
     }
 
     template <class Iterator>
-    bool operator<(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+    MYSTL_CONSTEXPR20 bool operator<(const move_iterator<Iterator>& lhs, const move_iterator<Iterator>& rhs) {
         return lhs.base() < rhs.base();
     }
 
     template <class Iterator>
-    bool operator!=(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+    MYSTL_CONSTEXPR20 bool operator!=(const move_iterator<Iterator>& lhs, const move_iterator<Iterator>& rhs) {
         return !(lhs == rhs);
     }
 
     template <class Iterator>
-    bool operator>(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+    MYSTL_CONSTEXPR20 bool operator>(const move_iterator<Iterator>& lhs, const move_iterator<Iterator>& rhs) {
         return rhs < lhs;
     }
 
     template <class Iterator>
-    bool operator<=(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+    MYSTL_CONSTEXPR20 bool operator<=(const move_iterator<Iterator>& lhs, const move_iterator<Iterator>& rhs) {
         return !(rhs < lhs);
     }
 
     template <class Iterator>
-    bool operator>=(const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
+    MYSTL_CONSTEXPR20 bool operator>=(const move_iterator<Iterator>& lhs, const move_iterator<Iterator>& rhs) {
         return !(lhs < rhs);
     }
 
+    // make_move_iterator
+    template <class Iterator>
+    MYSTL_CONSTEXPR20 move_iterator<Iterator> make_move_iterator(Iterator i) {
+        return move_iterator<Iterator>(i);
+    }
+
+    // move_iterator 解包为底层解包后的 move_iterator，如 move_iterator<T*>
+    template <class Iterator>
+    struct iter_unwrapper<move_iterator<Iterator>, false> {
+        using type = move_iterator<typename iter_unwrapper<Iterator>::type>;
+        static MYSTL_CONSTEXPR20 type unwrap(move_iterator<Iterator> i) {
+            return type(iter_unwrapper<Iterator>::unwrap(i.base()));
+        }
+        static MYSTL_CONSTEXPR20 move_iterator<Iterator> rewrap(move_iterator<Iterator> orig, type u) {
+            return move_iterator<Iterator>(iter_unwrapper<Iterator>::rewrap(orig.base(), u.base()));
+        }
+    };
+
 }  /* namespace laistl */
 
 
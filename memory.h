@@ -1,5 +1,5 @@
-#ifndef _MEMORY_H
-#define _MEMORY_H
+#ifndef _LAISTL_MEMORY_H
+#define _LAISTL_MEMORY_H
 
 // 负责更高级的动态内存管理，包含基本函数、空间配置器、未初始化的存储空间管理
 // 一个模板类 auto_ptr
@@ -81,13 +81,13 @@ namespace laistl {
     template <class ForwardIterator, class T>
     temporary_buffer<ForwardIterator, T>::
     temporary_buffer(ForwardIterator first, ForwardIterator last) {
-        try {
+        MYSTL_TRY {
             len = laistl::distance(first, last);
             allocate_buffer();
             if (len > 0) {
                 initialize_buffer(*first, std::is_trivially_default_constructible<T>());
             }
-        } catch (...) {
+        } MYSTL_CATCH_ALL {
             free(buffer);
             buffer = nullptr;
             len = 0;
@@ -165,4 +165,4 @@ namespace laistl {
 
 } /* namespace laistl */
 
-#endif /* _MEMORY_H */
+#endif /* _LAISTL_MEMORY_H */
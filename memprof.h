@@ -0,0 +1,356 @@
+#ifndef _MEMPROF_H
+#define _MEMPROF_H
+
+// laistl::memprof: 运行中的进程里哪些 vector 占着内存
+// 定义 MYSTL_MEMPROF 后，每个 vector 在构造完成时登记、析构时注销，登记项记录元素类型和构造位置；
+// 未定义时 vector 中的钩子为空宏，没有任何开销。同一个程序中的各翻译单元应一致地定义或不定义
+//
+//   memprof::totals()                 所有存活 vector 的容量、已用和浪费（cap_ - end_）的字节数
+//   memprof::report(out, top)         按构造位置和元素类型汇总，输出占用最多的 top 项
+//   memprof::dump_on_signal(SIGUSR1)  收到信号时由后台线程调用 report
+//   LAISTL_MEMPROF_SITE("name");      当前作用域内构造的 vector 以 name 作为构造位置
+//
+// 没有用 LAISTL_MEMPROF_SITE 标记时，构造位置是调用构造函数的返回地址，以 "模块+偏移" 输出，
+// 可用 addr2line -f -e 模块 偏移 查看；链接 -rdynamic 时直接输出函数名
+// 为使返回地址落在调用者中，定义 MYSTL_MEMPROF 时 vector 的构造函数不内联；移动构造的 vector 沿用源对象的构造位置
+// 旧版 glibc 需要链接 -ldl（dladdr）
+// report 在持锁状态下读取各 vector 的 size 和 capacity，其他线程同时修改的 vector 读到的值可能是旧的
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "exceptdef.h"
+
+namespace laistl {
+namespace memprof {
+    // 读取一个被登记对象的当前元素个数和容量
+    typedef void (*probe_fn)(const void* obj, size_t& size, size_t& cap);
+
+    struct entry {
+        const char* type;       // type_name<T>() 的结果，report 时解析出类型名
+        size_t elem_size;
+        probe_fn probe;
+        const void* site;       // 构造位置的返回地址
+        const char* tag;        // LAISTL_MEMPROF_SITE 指定的名字，优先于 site
+    };
+
+    struct registry {
+        std::mutex lock;
+        std::unordered_map<const void*, entry> live;
+    };
+
+    // 注册表不析构，静态存储期的 vector 在程序退出时注销仍然安全
+    inline registry& global() {
+        static registry* r = new registry;
+        return *r;
+    }
+
+    // 不依赖 RTTI 的类型名，report 时从函数签名中截取 "T = ..." 部分
+    template <class T>
+    const char* type_name() {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __PRETTY_FUNCTION__;
+    #else
+        return "?";
+    #endif
+    }
+
+    inline std::string parse_type_name(const char* pretty) {
+        const char* p = std::strstr(pretty, "T = ");
+        if (p == nullptr) {
+            return pretty;
+        }
+        p += 4;
+        const char* e = p + std::strlen(p);
+        if (e != p && e[-1] == ']') {
+            --e;
+        }
+        // GCC 在 T 之后可能还会列出其他模板参数，以 "; " 分隔
+        const char* semi = std::strstr(p, "; ");
+        if (semi != nullptr && semi < e) {
+            e = semi;
+        }
+        return std::string(p, e);
+    }
+
+    inline const char*& current_tag() {
+        static thread_local const char* tag = nullptr;
+        return tag;
+    }
+
+    // 作用域内构造的 vector 以 name 作为构造位置，可以嵌套
+    class site_tag {
+    public:
+        explicit site_tag(const char* name) noexcept : prev_(current_tag()) { current_tag() = name; }
+        ~site_tag() { current_tag() = prev_; }
+
+        site_tag(const site_tag&) = delete;
+        site_tag& operator=(const site_tag&) = delete;
+
+    private:
+        const char* prev_;
+    };
+
+    template <class V>
+    void probe(const void* obj, size_t& size, size_t& cap) {
+        const V* v = static_cast<const V*>(obj);
+        size = v->size();
+        cap = v->capacity();
+    }
+
+    template <class V>
+    entry make_entry(const void* site) noexcept {
+        entry e;
+        e.type = type_name<typename V::value_type>();
+        e.elem_size = sizeof(typename V::value_type);
+        e.probe = &probe<V>;
+        e.site = site;
+        e.tag = current_tag();
+        return e;
+    }
+
+    // 登记一个容器，site 是构造函数取得的返回地址。内存不足时放弃登记
+    template <class V>
+    void track(const V* v, const void* site) noexcept {
+        const entry e = make_entry<V>(site);
+        registry& r = global();
+        std::lock_guard<std::mutex> guard(r.lock);
+        MYSTL_TRY {
+            r.live[v] = e;
+        }
+        MYSTL_CATCH_ALL {
+        }
+    }
+
+    // 登记移动构造的容器，沿用 from 的构造位置和标记；from 未登记时按 site 登记
+    template <class V>
+    void track_moved(const V* v, const V* from, const void* site) noexcept {
+        registry& r = global();
+        std::lock_guard<std::mutex> guard(r.lock);
+        auto it = r.live.find(from);
+        const entry e = it != r.live.end() ? it->second : make_entry<V>(site);
+        MYSTL_TRY {
+            r.live[v] = e;
+        }
+        MYSTL_CATCH_ALL {
+        }
+    }
+
+    // 注销一个容器，在释放其缓冲区之前调用
+    inline void untrack(const void* v) noexcept {
+        registry& r = global();
+        std::lock_guard<std::mutex> guard(r.lock);
+        r.live.erase(v);
+    }
+
+    /*****************************************************************************************/
+
+    struct summary {
+        size_t containers;      // 持有缓冲区的容器数
+        size_t capacity_bytes;  // 缓冲区总字节数
+        size_t used_bytes;      // 已构造元素占用的字节数
+        size_t wasted_bytes;    // 预留未用的字节数
+
+        summary() : containers(0), capacity_bytes(0), used_bytes(0), wasted_bytes(0) {}
+
+        void add(size_t size, size_t cap, size_t elem) {
+            ++containers;
+            capacity_bytes += cap * elem;
+            used_bytes += size * elem;
+            wasted_bytes += (cap - size) * elem;
+        }
+    };
+
+    // 所有存活且持有缓冲区的容器的合计
+    inline summary totals() {
+        summary s;
+        registry& r = global();
+        std::lock_guard<std::mutex> guard(r.lock);
+        for (const auto& kv : r.live) {
+            size_t size = 0, cap = 0;
+            kv.second.probe(kv.first, size, cap);
+            if (cap != 0) {
+                s.add(size, cap, kv.second.elem_size);
+            }
+        }
+        return s;
+    }
+
+    // 构造位置的文字描述：标记名、函数名或 模块+偏移
+    inline std::string describe_site(const entry& e) {
+        if (e.tag != nullptr) {
+            return e.tag;
+        }
+        char buf[64];
+        Dl_info info;
+        if (e.site != nullptr && ::dladdr(e.site, &info) != 0) {
+            const uintptr_t addr = reinterpret_cast<uintptr_t>(e.site);
+            if (info.dli_sname != nullptr) {
+                snprintf(buf, sizeof(buf), "+0x%lx",
+                         static_cast<unsigned long>(addr - reinterpret_cast<uintptr_t>(info.dli_saddr)));
+                return std::string(info.dli_sname) + buf;
+            }
+            const char* module = info.dli_fname != nullptr ? info.dli_fname : "?";
+            const char* slash = std::strrchr(module, '/');
+            snprintf(buf, sizeof(buf), "+0x%lx",
+                     static_cast<unsigned long>(addr - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+            return std::string(slash != nullptr ? slash + 1 : module) + buf;
+        }
+        snprintf(buf, sizeof(buf), "%p", e.site);
+        return buf;
+    }
+
+    // 输出合计和按 (构造位置, 元素类型) 汇总后容量最大的 top 项
+    inline void report(FILE* out = stderr, size_t top = 20) {
+        struct group {
+            std::string site;
+            std::string type;
+            summary s;
+        };
+        struct key {
+            const void* site;
+            const char* tag;
+            const char* type;
+            bool operator==(const key& k) const {
+                return site == k.site && tag == k.tag && type == k.type;
+            }
+        };
+        struct key_hash {
+            size_t operator()(const key& k) const {
+                return std::hash<const void*>()(k.site) ^ (std::hash<const void*>()(k.tag) << 1) ^
+                       (std::hash<const void*>()(k.type) << 2);
+            }
+        };
+
+        std::unordered_map<key, group, key_hash> groups;
+        summary all;
+        {
+            registry& r = global();
+            std::lock_guard<std::mutex> guard(r.lock);
+            for (const auto& kv : r.live) {
+                const entry& e = kv.second;
+                size_t size = 0, cap = 0;
+                e.probe(kv.first, size, cap);
+                if (cap == 0) {
+                    continue;
+                }
+                all.add(size, cap, e.elem_size);
+                key k = { e.tag != nullptr ? nullptr : e.site, e.tag, e.type };
+                group& g = groups[k];
+                if (g.site.empty()) {
+                    g.site = describe_site(e);
+                    g.type = parse_type_name(e.type);
+                }
+                g.s.add(size, cap, e.elem_size);
+            }
+        }
+
+        std::vector<const group*> sorted;
+        for (const auto& kv : groups) {
+            sorted.push_back(&kv.second);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const group* a, const group* b) {
+            return a->s.capacity_bytes > b->s.capacity_bytes;
+        });
+
+        fprintf(out, "laistl memprof: %zu vectors, %zu bytes capacity, %zu used, %zu wasted\n",
+                all.containers, all.capacity_bytes, all.used_bytes, all.wasted_bytes);
+        fprintf(out, "%8s %14s %14s %7s  %-24s %s\n", "count", "capacity", "wasted", "waste%", "type", "site");
+        for (size_t i = 0; i < sorted.size() && i < top; ++i) {
+            const group& g = *sorted[i];
+            fprintf(out, "%8zu %14zu %14zu %6.1f%%  %-24s %s\n", g.s.containers, g.s.capacity_bytes,
+                    g.s.wasted_bytes, 100.0 * g.s.wasted_bytes / g.s.capacity_bytes,
+                    g.type.c_str(), g.site.c_str());
+        }
+        fflush(out);
+    }
+
+    /*****************************************************************************************/
+    // 信号触发：信号处理函数只向管道写一个字节，后台线程读到后在普通上下文中调用 report
+
+    inline int& signal_pipe_write_end() {
+        static int fd = -1;
+        return fd;
+    }
+
+    inline void on_dump_signal(int) {
+        const int saved = errno;
+        const char c = 1;
+        const ssize_t r = ::write(signal_pipe_write_end(), &c, 1);
+        (void)r;
+        errno = saved;
+    }
+
+    // 安装信号处理函数，收到 sig 时把报告写到 out；只能安装一次，成功返回 true
+    inline bool dump_on_signal(int sig = SIGUSR1, FILE* out = stderr, size_t top = 20) {
+        if (signal_pipe_write_end() >= 0) {
+            return false;
+        }
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            return false;
+        }
+        signal_pipe_write_end() = fds[1];
+        std::thread([fds, out, top]() {
+            char c;
+            for (;;) {
+                const ssize_t r = ::read(fds[0], &c, 1);
+                if (r < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (r <= 0) {
+                    return;
+                }
+                report(out, top);
+            }
+        }).detach();
+        struct sigaction sa;
+        std::memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = &on_dump_signal;
+        sigemptyset(&sa.sa_mask);
+        sa.sa_flags = SA_RESTART;
+        return ::sigaction(sig, &sa, nullptr) == 0;
+    }
+
+} /* namespace memprof */
+} /* namespace laistl */
+
+#define LAISTL_MEMPROF_CONCAT_IMPL(a, b) a##b
+#define LAISTL_MEMPROF_CONCAT(a, b) LAISTL_MEMPROF_CONCAT_IMPL(a, b)
+
+// 当前作用域内构造的 vector 以 name 作为构造位置
+#define LAISTL_MEMPROF_SITE(name) \
+    laistl::memprof::site_tag LAISTL_MEMPROF_CONCAT(laistl_memprof_site_, __LINE__)(name)
+
+// 容器内的登记钩子，只在定义了 MYSTL_MEMPROF 时生效
+#ifdef MYSTL_MEMPROF
+    // 构造函数不内联，其中取得的返回地址就是调用构造函数的位置
+    #if defined(__GNUC__) || defined(__clang__)
+        #define MYSTL_MEMPROF_CTOR      __attribute__((noinline))
+        #define MYSTL_MEMPROF_CALLER()  __builtin_return_address(0)
+    #else
+        #define MYSTL_MEMPROF_CTOR
+        #define MYSTL_MEMPROF_CALLER()  nullptr
+    #endif
+    // 常量求值中构造的 vector 不登记
+    #define MYSTL_MEMPROF_TRACK() \
+        (laistl::is_constant_evaluated() ? (void)0 : laistl::memprof::track(this, MYSTL_MEMPROF_CALLER()))
+    #define MYSTL_MEMPROF_TRACK_MOVED(rhs) \
+        (laistl::is_constant_evaluated() ? (void)0 \
+                                         : laistl::memprof::track_moved(this, &(rhs), MYSTL_MEMPROF_CALLER()))
+    #define MYSTL_MEMPROF_UNTRACK() \
+        (laistl::is_constant_evaluated() ? (void)0 : laistl::memprof::untrack(this))
+#endif
+
+#endif /* _MEMPROF_H */
@@ -0,0 +1,419 @@
+#ifndef _MMAP_VECTOR_H
+#define _MMAP_VECTOR_H
+
+// 以文件为后端存储的 vector：mmap_vector
+// 元素直接存放在 mmap 映射的文件中，打开已有文件时不复制、不解析；增长时 ftruncate 扩大文件再 mremap
+// 仅支持可平凡复制的元素类型，文件格式依赖本机字节序和 sizeof(T)
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
+    // 打开方式
+    enum class mmap_mode {
+        read_only,      // 只读映射，文件必须存在
+        read_write,     // 读写映射，文件不存在时创建
+        truncate        // 读写映射，清空已有内容
+    };
+
+    // 文件头，占一个 cache line，使元素区按 64 字节对齐
+    struct mmap_vector_header {
+        uint64_t magic;
+        uint64_t version;
+        uint64_t elem_size;
+        uint64_t size;
+        uint64_t reserved[4];
+    };
+
+    // 模板类：mmap_vector
+    // 文件布局为 [mmap_vector_header][T0][T1]...，文件长度 = 头部 + capacity() * sizeof(T)
+    // size 保存在映射内的文件头中，修改立即对映射可见，flush() 之后保证落盘
+    template <class T>
+    class mmap_vector {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "mmap_vector<T> requires a trivially copyable T");
+
+    public:
+        typedef T                                           value_type;
+        typedef T*                                          pointer;
+        typedef const T*                                    const_pointer;
+        typedef T&                                          reference;
+        typedef const T&                                    const_reference;
+        typedef size_t                                      size_type;
+        typedef ptrdiff_t                                   difference_type;
+
+        typedef T*                                          iterator;
+        typedef const T*                                    const_iterator;
+        typedef laistl::reverse_iterator<iterator>          reverse_iterator;
+        typedef laistl::reverse_iterator<const_iterator>    const_reverse_iterator;
+
+        static constexpr uint64_t file_magic = 0x5443455650414d4dULL;  // "MMAPVECT"
+        static constexpr uint64_t file_version = 1;
+
+    private:
+        static constexpr size_type header_size = sizeof(mmap_vector_header);
+
+        int         fd_;
+        char*       map_;       // 整个文件的映射，包括文件头
+        size_type   map_len_;   // 映射长度，等于文件长度
+        bool        writable_;
+
+    public:
+        // 构造、移动、析构函数
+        mmap_vector() noexcept : fd_(-1), map_(nullptr), map_len_(0), writable_(false) {}
+
+        explicit mmap_vector(const char* path, mmap_mode mode = mmap_mode::read_write)
+            : fd_(-1), map_(nullptr), map_len_(0), writable_(false) {
+            open(path, mode);
+        }
+
+        mmap_vector(mmap_vector&& rhs) noexcept
+            : fd_(rhs.fd_), map_(rhs.map_), map_len_(rhs.map_len_), writable_(rhs.writable_) {
+            rhs.fd_ = -1;
+            rhs.map_ = nullptr;
+            rhs.map_len_ = 0;
+            rhs.writable_ = false;
+        }
+
+        mmap_vector& operator=(mmap_vector&& rhs) noexcept {
+            if (this != &rhs) {
+                close();
+                swap(rhs);
+            }
+            return *this;
+        }
+
+        mmap_vector(const mmap_vector&) = delete;
+        mmap_vector& operator=(const mmap_vector&) = delete;
+
+        ~mmap_vector() { close(); }
+
+    public:
+        // 打开、关闭与同步
+        void open(const char* path, mmap_mode mode = mmap_mode::read_write);
+        void close() noexcept;
+        void flush(bool async = false);
+
+        bool is_open()     const noexcept { return map_ != nullptr; }
+        bool is_writable() const noexcept { return writable_; }
+
+    public:
+        // 迭代器操作
+        iterator                begin()         noexcept { return data(); }
+        const_iterator          begin()   const noexcept { return data(); }
+        iterator                end()           noexcept { return data() + size(); }
+        const_iterator          end()     const noexcept { return data() + size(); }
+
+        reverse_iterator        rbegin()        noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator  rbegin()  const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator        rend()          noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator  rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+        const_iterator          cbegin()  const noexcept { return begin(); }
+        const_iterator          cend()    const noexcept { return end(); }
+        const_reverse_iterator  crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator  crend()   const noexcept { return rend(); }
+
+    public:
+        // 容量相关操作
+        bool        empty()     const noexcept { return size() == 0; }
+        size_type   size()      const noexcept {
+            return map_ == nullptr ? 0 : static_cast<size_type>(header()->size);
+        }
+        size_type   capacity()  const noexcept {
+            return map_ == nullptr ? 0 : (map_len_ - header_size) / sizeof(T);
+        }
+        // 映射长度 header_size + n * sizeof(T) 须能放进 off_t 和 ptrdiff_t
+        size_type   max_size()  const noexcept { return (PTRDIFF_MAX - header_size) / sizeof(T); }
+
+        void reserve(size_type n);
+        void shrink_to_fit();
+
+    public:
+        // 访问元素相关操作
+        reference operator[](size_type n) {
+            MYSTL_CHECK_FAST(n < size());
+            return data()[n];
+        }
+        const_reference operator[](size_type n) const {
+            MYSTL_CHECK_FAST(n < size());
+            return data()[n];
+        }
+
+        reference at(size_type n) {
+            THROW_OUT_OF_RANGE_IF(n >= size(), "mmap_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const {
+            THROW_OUT_OF_RANGE_IF(n >= size(), "mmap_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference front()             { MYSTL_CHECK_FAST(!empty()); return data()[0]; }
+        const_reference front() const { MYSTL_CHECK_FAST(!empty()); return data()[0]; }
+        reference back()              { MYSTL_CHECK_FAST(!empty()); return data()[size() - 1]; }
+        const_reference back()  const { MYSTL_CHECK_FAST(!empty()); return data()[size() - 1]; }
+
+        pointer       data()       noexcept {
+            return map_ == nullptr ? nullptr : reinterpret_cast<pointer>(map_ + header_size);
+        }
+        const_pointer data() const noexcept {
+            return map_ == nullptr ? nullptr : reinterpret_cast<const_pointer>(map_ + header_size);
+        }
+
+    public:
+        // 修改容器相关操作，要求以可写方式打开
+        void push_back(const value_type& value) {
+            check_writable();
+            const size_type n = size();
+            if (n == capacity()) {
+                // value 可能引用自身元素，mremap 移动映射前先复制一份
+                const value_type copy = value;
+                grow(n + 1);
+                data()[n] = copy;
+            } else {
+                data()[n] = value;
+            }
+            header()->size = n + 1;
+        }
+
+        void pop_back() {
+            MYSTL_CHECK_FAST(!empty());
+            check_writable();
+            --header()->size;
+        }
+
+        // 追加 [first, first + n)
+        void append(const value_type* first, size_type n);
+        void assign(const value_type* first, size_type n) {
+            clear();
+            append(first, n);
+        }
+
+        void resize(size_type new_size) { resize(new_size, value_type()); }
+        void resize(size_type new_size, const value_type& value);
+
+        void clear() {
+            if (map_ != nullptr) {
+                check_writable();
+                header()->size = 0;
+            }
+        }
+
+        void swap(mmap_vector& rhs) noexcept {
+            laistl::swap(fd_, rhs.fd_);
+            laistl::swap(map_, rhs.map_);
+            laistl::swap(map_len_, rhs.map_len_);
+            laistl::swap(writable_, rhs.writable_);
+        }
+
+    private:
+        // helper functions
+        mmap_vector_header*       header()       noexcept { return reinterpret_cast<mmap_vector_header*>(map_); }
+        const mmap_vector_header* header() const noexcept { return reinterpret_cast<const mmap_vector_header*>(map_); }
+
+        void check_writable() const {
+            THROW_RUNTIME_ERROR_IF(!writable_, "mmap_vector<T> is not opened for writing");
+        }
+
+        void grow(size_type need);
+        void remap(size_type new_cap);
+    };
+
+    /*****************************************************************************************/
+
+    // open: 打开文件并映射，新文件写入文件头；已有文件校验文件头
+    template <class T>
+    void mmap_vector<T>::open(const char* path, mmap_mode mode) {
+        close();
+        const bool writable = mode != mmap_mode::read_only;
+        int flags = writable ? (O_RDWR | O_CREAT) : O_RDONLY;
+        if (mode == mmap_mode::truncate) {
+            flags |= O_TRUNC;
+        }
+        const int fd = ::open(path, flags, 0644);
+        THROW_RUNTIME_ERROR_IF(fd < 0, "mmap_vector<T>::open() cannot open file");
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            THROW_RUNTIME_ERROR_IF(true, "mmap_vector<T>::open() fstat failed");
+        }
+        size_type len = static_cast<size_type>(st.st_size);
+        const bool fresh = len == 0;
+        if (fresh) {
+            if (!writable || ::ftruncate(fd, static_cast<off_t>(header_size)) != 0) {
+                ::close(fd);
+                THROW_RUNTIME_ERROR_IF(true, "mmap_vector<T>::open() empty or unwritable file");
+            }
+            len = header_size;
+        }
+        if (len < header_size || (len - header_size) % sizeof(T) != 0) {
+            ::close(fd);
+            THROW_RUNTIME_ERROR_IF(true, "mmap_vector<T>::open() bad file length");
+        }
+
+        const int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        void* p = ::mmap(nullptr, len, prot, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            THROW_RUNTIME_ERROR_IF(true, "mmap_vector<T>::open() mmap failed");
+        }
+        fd_ = fd;
+        map_ = static_cast<char*>(p);
+        map_len_ = len;
+        writable_ = writable;
+
+        if (fresh) {
+            mmap_vector_header* h = header();
+            std::memset(h, 0, header_size);
+            h->magic = file_magic;
+            h->version = file_version;
+            h->elem_size = sizeof(T);
+            h->size = 0;
+            return;
+        }
+        const mmap_vector_header* h = header();
+        if (h->magic != file_magic || h->version != file_version || h->elem_size != sizeof(T) ||
+            h->size > capacity()) {
+            close();
+            THROW_RUNTIME_ERROR_IF(true, "mmap_vector<T>::open() bad file header");
+        }
+    }
+
+    // close: 解除映射并关闭文件，不主动 msync，由内核回写
+    template <class T>
+    void mmap_vector<T>::close() noexcept {
+        if (map_ != nullptr) {
+            ::munmap(map_, map_len_);
+            map_ = nullptr;
+            map_len_ = 0;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        writable_ = false;
+    }
+
+    // flush: 用 msync 把映射写回文件，async 为 true 时只发起回写不等待
+    template <class T>
+    void mmap_vector<T>::flush(bool async) {
+        if (map_ == nullptr || !writable_) {
+            return;
+        }
+        THROW_RUNTIME_ERROR_IF(::msync(map_, map_len_, async ? MS_ASYNC : MS_SYNC) != 0,
+                               "mmap_vector<T>::flush() msync failed");
+    }
+
+    // reserve
+    template <class T>
+    void mmap_vector<T>::reserve(size_type n) {
+        if (capacity() < n) {
+            THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in mmap_vector<T>::reserve(n)");
+            remap(n);
+        }
+    }
+
+    // shrink_to_fit: 把文件截断到恰好容纳 size() 个元素
+    template <class T>
+    void mmap_vector<T>::shrink_to_fit() {
+        if (map_ != nullptr && size() < capacity()) {
+            remap(size());
+        }
+    }
+
+    // append
+    // [first, first + n) 可以位于自身的映射中（包括 assign 清空后的旧内容），扩容后按偏移重新定位
+    template <class T>
+    void mmap_vector<T>::append(const value_type* first, size_type n) {
+        check_writable();
+        const size_type old_size = size();
+        THROW_LENGTH_ERROR_IF(n > max_size() - old_size, "mmap_vector<T>'s size too big");
+        if (capacity() - old_size < n) {
+            const value_type* old_data = data();
+            const bool inside = old_data != nullptr && first >= old_data && first < old_data + capacity();
+            const size_type offset = inside ? static_cast<size_type>(first - old_data) : 0;
+            grow(old_size + n);
+            if (inside) {
+                first = data() + offset;
+            }
+        }
+        if (n != 0) {
+            std::memmove(data() + old_size, first, n * sizeof(T));
+        }
+        header()->size = old_size + n;
+    }
+
+    // resize
+    template <class T>
+    void mmap_vector<T>::resize(size_type new_size, const value_type& value) {
+        check_writable();
+        const size_type old_size = size();
+        if (new_size > old_size) {
+            // value 可能引用自身元素，先复制再扩容
+            const value_type copy = value;
+            if (new_size > capacity()) {
+                grow(new_size);
+            }
+            laistl::fill_n(data() + old_size, new_size - old_size, copy);
+        }
+        header()->size = new_size;
+    }
+
+    // grow: 容量至少扩大到 need，按 1.5 倍增长，最小一页
+    template <class T>
+    void mmap_vector<T>::grow(size_type need) {
+        THROW_RUNTIME_ERROR_IF(map_ == nullptr, "mmap_vector<T> is not opened");
+        THROW_LENGTH_ERROR_IF(need > max_size(), "mmap_vector<T>'s size too big");
+        const size_type old_cap = capacity();
+        const size_type page_elems = static_cast<size_type>(::sysconf(_SC_PAGESIZE)) / sizeof(T);
+        size_type new_cap = old_cap > max_size() - old_cap / 2 ? max_size() : old_cap + old_cap / 2;
+        new_cap = laistl::max(new_cap, laistl::max(need, page_elems));
+        remap(new_cap);
+    }
+
+    // remap: ftruncate 改变文件长度，再用 mremap 调整映射，映射地址可能改变
+    template <class T>
+    void mmap_vector<T>::remap(size_type new_cap) {
+        check_writable();
+        MYSTL_DEBUG(new_cap >= size());
+        const size_type new_len = header_size + new_cap * sizeof(T);
+        const bool growing = new_len > map_len_;
+        // 扩大时先加长文件再映射，缩小时先缩小映射再截断文件，保证映射不越过文件末尾
+        if (growing) {
+            THROW_RUNTIME_ERROR_IF(::ftruncate(fd_, static_cast<off_t>(new_len)) != 0,
+                                   "mmap_vector<T> ftruncate failed");
+        }
+        void* p = ::mremap(map_, map_len_, new_len, MREMAP_MAYMOVE);
+        THROW_RUNTIME_ERROR_IF(p == MAP_FAILED, "mmap_vector<T> mremap failed");
+        map_ = static_cast<char*>(p);
+        map_len_ = new_len;
+        if (!growing) {
+            THROW_RUNTIME_ERROR_IF(::ftruncate(fd_, static_cast<off_t>(new_len)) != 0,
+                                   "mmap_vector<T> ftruncate failed");
+        }
+    }
+
+    // 重载 swap
+    template <class T>
+    void swap(mmap_vector<T>& lhs, mmap_vector<T>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
+} /* namespace laistl */
+
+#endif /* _MMAP_VECTOR_H */
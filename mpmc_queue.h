@@ -0,0 +1,252 @@
+#ifndef _MPMC_QUEUE_H
+#define _MPMC_QUEUE_H
+
+// 有界多生产者/多消费者无锁队列
+// 每个槽位带一个序号，生产者和消费者通过 CAS 抢占下标，再根据序号判断槽位是否可用
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace laistl {
+    // 模板类：mpmc_queue
+    // 槽位 i 的序号初始为 i；写入下标 pos 后序号变为 pos + 1，读出后变为 pos + capacity
+    // 构造元素时抛出异常的槽位仍按已写入发布，但标记为无效，消费者跳过它
+    template <class T>
+    class mpmc_queue {
+    private:
+        struct cell {
+            std::atomic<size_t> seq;
+            bool valid;     // 是否存放着构造成功的元素，在发布 seq 之前写入
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+            T* value() { return reinterpret_cast<T*>(&storage); }
+        };
+
+    public:
+        using allocator_type = laistl::allocator<T>;
+        using cell_allocator = laistl::allocator<cell>;
+
+        typedef typename allocator_type::value_type         value_type;
+        typedef typename allocator_type::reference          reference;
+        typedef typename allocator_type::const_reference    const_reference;
+        typedef typename allocator_type::size_type          size_type;
+
+    private:
+        // 只读部分，构造后不再修改
+        alignas(cache_line_size) cell* buffer_;     // 按缓存行对齐的槽位数组
+        size_type mask_;                            // 容量 - 1
+
+        alignas(cache_line_size) std::atomic<size_type> enqueue_pos_;   // 下一个写入下标
+        alignas(cache_line_size) std::atomic<size_type> dequeue_pos_;   // 下一个读取下标
+        char pad_[cache_line_size - sizeof(std::atomic<size_type>)];    // 与后续对象隔开
+
+    public:
+        // 构造、析构函数
+        explicit mpmc_queue(size_type n);
+        ~mpmc_queue();
+
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    public:
+        // 容量相关操作，在并发读写时只是一个近似值
+        size_type capacity() const noexcept { return mask_ + 1; }
+        size_type size() const noexcept {
+            const size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+            const size_type head = dequeue_pos_.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+        bool empty() const noexcept { return size() == 0; }
+
+    public:
+        // 非阻塞版本，队列满 / 空时立即返回 false
+        bool try_push(const value_type& value) { return try_emplace(value); }
+        bool try_push(value_type&& value) { return try_emplace(laistl::move(value)); }
+
+        template <class... Args>
+        bool try_emplace(Args&& ...args);
+
+        bool try_pop(value_type& value);
+
+        // 阻塞版本，队列满 / 空时自旋退避直到成功
+        void push(const value_type& value) { emplace(value); }
+        void push(value_type&& value) { emplace(laistl::move(value)); }
+
+        template <class... Args>
+        void emplace(Args&& ...args);
+
+        void pop(value_type& value);
+
+    private:
+        // helper functions
+        static size_type round_up_pow2(size_type n);
+        static void backoff(unsigned& spins);
+        static void cpu_relax() noexcept;
+    };
+
+    // 构造函数
+    template <class T>
+    mpmc_queue<T>::mpmc_queue(size_type n)
+        : buffer_(nullptr), mask_(0), enqueue_pos_(0), dequeue_pos_(0)
+    {
+        const size_type cap = round_up_pow2(n);
+        buffer_ = cell_allocator::allocate_aligned(cap, cache_line_size);
+        for (size_type i = 0; i < cap; ++i) {
+            ::new ((void*)&buffer_[i].seq) std::atomic<size_t>(i);
+        }
+        mask_ = cap - 1;
+    }
+
+    // 析构函数，销毁尚未被取出的元素
+    template <class T>
+    mpmc_queue<T>::~mpmc_queue() {
+        const size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+        for (size_type head = dequeue_pos_.load(std::memory_order_relaxed); head != tail; ++head) {
+            cell& c = buffer_[head & mask_];
+            if (c.valid) {
+                laistl::destroy(c.value());
+            }
+        }
+        cell_allocator::deallocate_aligned(buffer_);
+    }
+
+    // 在队尾就地构造元素，队列已满时返回 false
+    template <class T>
+    template <class ...Args>
+    bool mpmc_queue<T>::try_emplace(Args&& ...args) {
+        cell* c;
+        size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            c = &buffer_[pos & mask_];
+            const size_type seq = c->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+            if (diff == 0) {
+                // 槽位空闲，抢占下标；失败时 pos 被更新为最新值
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // 槽位上一轮的元素还未被取走，队列已满
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        // 下标已被占用，构造失败时也必须发布槽位，否则消费者会一直等待它
+        MYSTL_TRY {
+            laistl::construct(c->value(), laistl::forward<Args>(args)...);
+        }
+        MYSTL_CATCH_ALL {
+            c->valid = false;
+            c->seq.store(pos + 1, std::memory_order_release);
+            MYSTL_RETHROW;
+        }
+        c->valid = true;
+        c->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 从队头取出一个元素，队列为空时返回 false；跳过构造失败的槽位
+    // 移动赋值抛出异常时该元素被丢弃，槽位照常释放
+    template <class T>
+    bool mpmc_queue<T>::try_pop(value_type& value) {
+        cell* c;
+        size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            c = &buffer_[pos & mask_];
+            const size_type seq = c->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    if (c->valid) {
+                        break;
+                    }
+                    c->seq.store(pos + mask_ + 1, std::memory_order_release);
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            } else if (diff < 0) {
+                // 槽位还未被写入，队列为空
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        MYSTL_TRY {
+            value = laistl::move(*c->value());
+        }
+        MYSTL_CATCH_ALL {
+            laistl::destroy(c->value());
+            c->seq.store(pos + mask_ + 1, std::memory_order_release);
+            MYSTL_RETHROW;
+        }
+        laistl::destroy(c->value());
+        c->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <class T>
+    template <class ...Args>
+    void mpmc_queue<T>::emplace(Args&& ...args) {
+        unsigned spins = 0;
+        while (!try_emplace(laistl::forward<Args>(args)...)) {
+            backoff(spins);
+        }
+    }
+
+    template <class T>
+    void mpmc_queue<T>::pop(value_type& value) {
+        unsigned spins = 0;
+        while (!try_pop(value)) {
+            backoff(spins);
+        }
+    }
+
+    // helper functions
+    // round_up_pow2: 把容量向上取整为 2 的幂，至少为 2；取整后无法分配的容量抛出 length_error
+    template <class T>
+    typename mpmc_queue<T>::size_type
+    mpmc_queue<T>::round_up_pow2(size_type n) {
+        const size_type max_cap = (static_cast<size_type>(-1) / 2 + 1) / sizeof(cell);
+        THROW_LENGTH_ERROR_IF(n > max_cap, "mpmc_queue<T>'s capacity too big");
+        size_type cap = 2;
+        while (cap < n) {
+            cap <<= 1;
+        }
+        return cap;
+    }
+
+    // backoff: 先短暂自旋，多次失败后让出 CPU
+    template <class T>
+    void mpmc_queue<T>::backoff(unsigned& spins) {
+        if (spins < 64) {
+            ++spins;
+            for (unsigned i = 0; i < spins; ++i) {
+                cpu_relax();
+            }
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    // cpu_relax: 自旋等待提示，x86 上为 pause；同时作为编译器屏障，防止空循环被优化掉
+    template <class T>
+    void mpmc_queue<T>::cpu_relax() noexcept {
+    #if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+    #elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+    #elif defined(__GNUC__) || defined(__clang__)
+        asm volatile("" ::: "memory");
+    #else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    #endif
+    }
+
+} /* namespace laistl */
+
+#endif /* _MPMC_QUEUE_H */
@@ -0,0 +1,343 @@
+#ifndef _PERF_H
+#define _PERF_H
+
+// laistl::perf: 硬件性能计数器的作用域测量
+// 在作用域的开始和结束读取 perf_event_open 计数器（周期、指令、L1D/LLC 缺失、分支预测失败、缺页），
+// 按调用点累计；计数器不可用时（非 Linux、权限不足、虚拟机不支持）只记录耗时
+//
+//   LAISTL_PERF_SCOPE("name");          在当前作用域测量，按调用点累计，perf::report() 输出
+//   perf::sample s; { perf::scope sc(s); ... }   测量一段代码，结果写入 s，供基准程序使用
+//
+// 定义 MYSTL_PERF_HOOKS 后，vector::reallocate_emplace/reallocate_insert 和 unchecked_copy 等热点路径内置的测量点生效，
+// 未定义时这些测量点为空宏，没有任何开销
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace laistl {
+namespace perf {
+    // 计数器种类
+    enum counter {
+        cycles,
+        instructions,
+        l1d_misses,
+        llc_misses,
+        branch_misses,
+        page_faults,
+        counter_count
+    };
+
+    inline const char* counter_name(int c) {
+        static const char* const names[counter_count] = {
+            "cycles", "instructions", "l1d-misses", "llc-misses", "branch-misses", "page-faults"
+        };
+        return names[c];
+    }
+
+    // 一次测量的结果，valid 标记对应的计数器是否可用
+    struct sample {
+        uint64_t ns;
+        uint64_t values[counter_count];
+        bool valid[counter_count];
+
+        sample() : ns(0) {
+            for (int i = 0; i < counter_count; ++i) {
+                values[i] = 0;
+                valid[i] = false;
+            }
+        }
+    };
+
+    /*****************************************************************************************/
+    // counter_group: 每个线程一组计数器，首个打开成功的计数器作为组长，整组一次 read 读出
+
+    class counter_group {
+    public:
+        counter_group() : leader_(-1), nr_(0) {
+            for (int i = 0; i < counter_count; ++i) {
+                slot_[i] = -1;
+                fds_[i] = -1;
+            }
+            open_all();
+        }
+
+        ~counter_group() {
+            for (int i = 0; i < nr_; ++i) {
+        #ifdef __linux__
+                ::close(fds_[i]);
+        #endif
+            }
+        }
+
+        counter_group(const counter_group&) = delete;
+        counter_group& operator=(const counter_group&) = delete;
+
+        bool available() const noexcept { return nr_ != 0; }
+        bool has(int c) const noexcept { return slot_[c] >= 0; }
+
+        // 读取当前计数，按启用时间与实际运行时间的比例换算被复用的计数器
+        bool read(uint64_t out[counter_count]) const noexcept {
+        #ifdef __linux__
+            if (nr_ == 0) {
+                return false;
+            }
+            uint64_t buf[3 + counter_count];
+            const ssize_t want = static_cast<ssize_t>((3 + nr_) * sizeof(uint64_t));
+            if (::read(leader_, buf, sizeof(buf)) < want) {
+                return false;
+            }
+            const uint64_t enabled = buf[1];
+            const uint64_t running = buf[2];
+            for (int c = 0; c < counter_count; ++c) {
+                if (slot_[c] < 0) {
+                    continue;
+                }
+                uint64_t v = buf[3 + slot_[c]];
+                if (running != 0 && running < enabled) {
+                    v = static_cast<uint64_t>(static_cast<double>(v) * enabled / running);
+                }
+                out[c] = v;
+            }
+            return true;
+        #else
+            (void)out;
+            return false;
+        #endif
+        }
+
+        // 当前线程的计数器组，首次使用时打开
+        static counter_group& local() {
+            static thread_local counter_group group;
+            return group;
+        }
+
+    private:
+        void open_all() {
+        #ifdef __linux__
+            struct event { uint32_t type; uint64_t config; };
+            const event events[counter_count] = {
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+                { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+                { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS }
+            };
+            for (int c = 0; c < counter_count; ++c) {
+                struct perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = events[c].type;
+                attr.config = events[c].config;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                   PERF_FORMAT_TOTAL_TIME_RUNNING;
+                const int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, leader_, 0));
+                if (fd < 0) {
+                    continue;
+                }
+                if (leader_ < 0) {
+                    leader_ = fd;
+                }
+                slot_[c] = nr_;
+                fds_[nr_++] = fd;
+            }
+        #endif
+        }
+
+        int leader_;
+        int nr_;
+        int slot_[counter_count];   // 计数器在组读取结果中的位置，-1 表示不可用
+        int fds_[counter_count];
+    };
+
+    /*****************************************************************************************/
+    // site: 一个调用点的累计结果，各线程用原子加累计；所有调用点串成一个链表供 report 遍历
+
+    struct site {
+        const char* name;
+        const char* file;
+        int line;
+        std::atomic<uint64_t> calls;
+        std::atomic<uint64_t> ns;
+        std::atomic<uint64_t> values[counter_count];
+        bool valid[counter_count];
+        site* next;
+
+        site(const char* n, const char* f, int l) : name(n), file(f), line(l), calls(0), ns(0), next(nullptr) {
+            for (int i = 0; i < counter_count; ++i) {
+                values[i].store(0, std::memory_order_relaxed);
+                valid[i] = counter_group::local().has(i);
+            }
+            next = head().load(std::memory_order_relaxed);
+            while (!head().compare_exchange_weak(next, this, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {}
+        }
+
+        site(const site&) = delete;
+        site& operator=(const site&) = delete;
+
+        void add(const sample& s) noexcept {
+            calls.fetch_add(1, std::memory_order_relaxed);
+            ns.fetch_add(s.ns, std::memory_order_relaxed);
+            for (int i = 0; i < counter_count; ++i) {
+                if (s.valid[i]) {
+                    values[i].fetch_add(s.values[i], std::memory_order_relaxed);
+                }
+            }
+        }
+
+        static std::atomic<site*>& head() {
+            static std::atomic<site*> h(nullptr);
+            return h;
+        }
+    };
+
+    /*****************************************************************************************/
+    // scope: 构造时读取起点，析构时计算差值，写入 sample 或累计到 site
+
+    class scope {
+    public:
+        explicit scope(sample& out) noexcept : out_(&out), site_(nullptr) { begin(); }
+        explicit scope(site& s) noexcept : out_(nullptr), site_(&s) { begin(); }
+
+        ~scope() {
+            uint64_t end[counter_count] = {};
+            const bool ok = group_.read(end);
+            const auto t = clock_type::now();
+            sample s;
+            s.ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t - start_).count());
+            for (int i = 0; i < counter_count; ++i) {
+                s.valid[i] = ok && started_ && group_.has(i);
+                s.values[i] = s.valid[i] ? end[i] - begin_[i] : 0;
+            }
+            if (out_ != nullptr) {
+                *out_ = s;
+            } else {
+                site_->add(s);
+            }
+        }
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+    private:
+        typedef std::chrono::steady_clock clock_type;
+
+        void begin() noexcept {
+            started_ = group_.read(begin_);
+            start_ = clock_type::now();
+        }
+
+        counter_group& group_ = counter_group::local();
+        sample* out_;
+        site* site_;
+        bool started_;
+        uint64_t begin_[counter_count];
+        clock_type::time_point start_;
+    };
+
+    /*****************************************************************************************/
+
+    // 当前线程的硬件计数器是否可用，不可用时只有耗时
+    inline bool counters_available() {
+        return counter_group::local().available();
+    }
+
+    // 模板的每个实例化各有一个静态 site，名字、文件和行号都相同时视为同一个调用点
+    inline bool same_site(const site* a, const site* b) {
+        return a->line == b->line && std::strcmp(a->name, b->name) == 0 && std::strcmp(a->file, b->file) == 0;
+    }
+
+    // 输出所有调用点的累计结果，每次调用的平均值；同一调用点的各实例化合并为一行
+    inline void report(FILE* out = stderr) {
+        fprintf(out, "%-32s %10s %12s", "site", "calls", "ns/call");
+        for (int i = 0; i < counter_count; ++i) {
+            fprintf(out, " %14s", counter_name(i));
+        }
+        fprintf(out, " %6s\n", "IPC");
+        site* const first = site::head().load(std::memory_order_acquire);
+        for (site* s = first; s != nullptr; s = s->next) {
+            bool merged = false;
+            for (site* p = first; p != s && !merged; p = p->next) {
+                merged = same_site(p, s);
+            }
+            if (merged) {
+                continue;   // 已在第一次出现时输出
+            }
+            uint64_t calls = 0;
+            sample total;
+            for (site* t = s; t != nullptr; t = t->next) {
+                if (!same_site(s, t)) {
+                    continue;
+                }
+                calls += t->calls.load(std::memory_order_relaxed);
+                total.ns += t->ns.load(std::memory_order_relaxed);
+                for (int i = 0; i < counter_count; ++i) {
+                    if (t->valid[i]) {
+                        total.valid[i] = true;
+                        total.values[i] += t->values[i].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+            if (calls == 0) {
+                continue;
+            }
+            fprintf(out, "%-32s %10llu %12.1f", s->name, static_cast<unsigned long long>(calls),
+                    double(total.ns) / calls);
+            for (int i = 0; i < counter_count; ++i) {
+                if (total.valid[i]) {
+                    fprintf(out, " %14.1f", double(total.values[i]) / calls);
+                } else {
+                    fprintf(out, " %14s", "-");
+                }
+            }
+            if (total.valid[cycles] && total.valid[instructions] && total.values[cycles] != 0) {
+                fprintf(out, " %6.2f\n", double(total.values[instructions]) / total.values[cycles]);
+            } else {
+                fprintf(out, " %6s\n", "-");
+            }
+        }
+    }
+
+    // 清零所有调用点的累计结果
+    inline void reset() {
+        for (site* s = site::head().load(std::memory_order_acquire); s != nullptr; s = s->next) {
+            s->calls.store(0, std::memory_order_relaxed);
+            s->ns.store(0, std::memory_order_relaxed);
+            for (int i = 0; i < counter_count; ++i) {
+                s->values[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+} /* namespace perf */
+} /* namespace laistl */
+
+#define LAISTL_PERF_CONCAT_IMPL(a, b) a##b
+#define LAISTL_PERF_CONCAT(a, b) LAISTL_PERF_CONCAT_IMPL(a, b)
+
+// 在当前作用域测量，结果按调用点累计
+#define LAISTL_PERF_SCOPE(name) \
+    static laistl::perf::site LAISTL_PERF_CONCAT(laistl_perf_site_, __LINE__)(name, __FILE__, __LINE__); \
+    laistl::perf::scope LAISTL_PERF_CONCAT(laistl_perf_scope_, __LINE__)(LAISTL_PERF_CONCAT(laistl_perf_site_, __LINE__))
+
+// 库内热点路径的测量点，只在定义了 MYSTL_PERF_HOOKS 时生效
+#ifdef MYSTL_PERF_HOOKS
+    #define MYSTL_PERF_HOOK(name) LAISTL_PERF_SCOPE(name)
+#endif
+
+#endif /* _PERF_H */
@@ -0,0 +1,1024 @@
+#ifndef _PERSISTENT_VECTOR_H
+#define _PERSISTENT_VECTOR_H
+
+// 不可变的持久化 vector：persistent_vector，以及用于批量修改的 transient_vector
+// 基于 32 叉的 RRB 树（relaxed radix balanced tree），修改操作返回新版本，新旧版本共享未改动的节点
+// set 为 O(log32 n)，push_back 均摊 O(1)，concat / take / drop 为 O(log n)
+
+#include <atomic>
+#include <initializer_list>
+#include <type_traits>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
+    template <class T>
+    class transient_vector;
+
+    // 模板类：persistent_vector
+    // 树的叶节点存放元素，内部节点存放子节点指针；平衡节点按下标的位段直接定位子节点，
+    // 拼接或切片产生的不满节点为“宽松”节点，额外保存子树大小的前缀和表
+    // 最后一个叶节点单独作为 tail 保存，push_back 只修改 tail，满 32 个元素后才并入树中
+    // 节点用原子引用计数管理，不同线程可以安全地持有共享节点的不同版本
+    template <class T>
+    class persistent_vector {
+        friend class transient_vector<T>;
+
+    public:
+        typedef T               value_type;
+        typedef const T*        const_pointer;
+        typedef const T&        const_reference;
+        typedef size_t          size_type;
+        typedef ptrdiff_t       difference_type;
+
+        class const_iterator;
+        typedef const_iterator  iterator;
+
+        static constexpr size_type branch_bits = 5;
+        static constexpr size_type branch = size_type(1) << branch_bits;   // 每个节点的分支数 32
+
+    private:
+        struct node_base {
+            std::atomic<size_type>  refs;
+            size_type               count;
+        };
+
+        struct leaf_node : node_base {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[branch];
+
+            T*       values()       noexcept { return reinterpret_cast<T*>(slots); }
+            const T* values() const noexcept { return reinterpret_cast<const T*>(slots); }
+        };
+
+        struct inner_node : node_base {
+            bool        relaxed;            // 为 true 时 sizes 有效
+            size_type   sizes[branch];      // 子树大小的前缀和
+            node_base*  child[branch];
+        };
+
+        typedef laistl::allocator<leaf_node>    leaf_allocator;
+        typedef laistl::allocator<inner_node>   inner_allocator;
+
+        node_base*  root_;      // 树根，高度由 shift_ 表示，shift_ 为 0 时根是叶节点
+        leaf_node*  tail_;      // 尾部叶节点，可以为空
+        size_type   size_;
+        size_type   shift_;
+
+    public:
+        // 构造、复制、移动、析构函数，复制为 O(1)
+        persistent_vector() noexcept : root_(nullptr), tail_(nullptr), size_(0), shift_(0) {}
+
+        persistent_vector(std::initializer_list<value_type> ilist)
+            : root_(nullptr), tail_(nullptr), size_(0), shift_(0) {
+            for (const auto& value : ilist) {
+                push_back_inplace(value);
+            }
+        }
+
+        template <class Iter, typename std::enable_if<
+            laistl::is_input_iterator<Iter>::value, int>::type = 0>
+        persistent_vector(Iter first, Iter last)
+            : root_(nullptr), tail_(nullptr), size_(0), shift_(0) {
+            for (; first != last; ++first) {
+                push_back_inplace(*first);
+            }
+        }
+
+        persistent_vector(const persistent_vector& rhs) noexcept
+            : root_(retain(rhs.root_)), tail_(retain(rhs.tail_)), size_(rhs.size_), shift_(rhs.shift_) {}
+
+        persistent_vector(persistent_vector&& rhs) noexcept
+            : root_(rhs.root_), tail_(rhs.tail_), size_(rhs.size_), shift_(rhs.shift_) {
+            rhs.root_ = nullptr;
+            rhs.tail_ = nullptr;
+            rhs.size_ = 0;
+            rhs.shift_ = 0;
+        }
+
+        persistent_vector& operator=(const persistent_vector& rhs) noexcept {
+            persistent_vector(rhs).swap(*this);
+            return *this;
+        }
+
+        persistent_vector& operator=(persistent_vector&& rhs) noexcept {
+            persistent_vector(laistl::move(rhs)).swap(*this);
+            return *this;
+        }
+
+        ~persistent_vector() { reset(); }
+
+    public:
+        // 迭代器与访问元素操作
+        const_iterator begin()  const noexcept { return const_iterator(this, 0); }
+        const_iterator end()    const noexcept { return const_iterator(this, size_); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend()   const noexcept { return end(); }
+
+        bool      empty() const noexcept { return size_ == 0; }
+        size_type size()  const noexcept { return size_; }
+
+        const_reference operator[](size_type n) const {
+            MYSTL_CHECK_FAST(n < size_);
+            size_type start;
+            return leaf_for(n, start)[n - start];
+        }
+
+        const_reference at(size_type n) const {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "persistent_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        const_reference front() const { MYSTL_CHECK_FAST(!empty()); return (*this)[0]; }
+        const_reference back()  const { MYSTL_CHECK_FAST(!empty()); return (*this)[size_ - 1]; }
+
+    public:
+        // 产生新版本的操作，*this 不变
+        persistent_vector set(size_type n, const value_type& value) const {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "persistent_vector<T>::set() subscript out of range");
+            persistent_vector r(*this);
+            r.set_inplace(n, value);
+            return r;
+        }
+
+        persistent_vector push_back(const value_type& value) const {
+            persistent_vector r(*this);
+            r.push_back_inplace(value);
+            return r;
+        }
+
+        persistent_vector pop_back() const {
+            MYSTL_CHECK_FAST(!empty());
+            return take(size_ - 1);
+        }
+
+        // 前 n 个元素
+        persistent_vector take(size_type n) const {
+            persistent_vector r(*this);
+            r.take_inplace(n);
+            return r;
+        }
+
+        // 去掉前 n 个元素
+        persistent_vector drop(size_type n) const {
+            persistent_vector r(*this);
+            r.drop_inplace(n);
+            return r;
+        }
+
+        // [first, last) 区间
+        persistent_vector slice(size_type first, size_type last) const {
+            MYSTL_DEBUG(first <= last && last <= size_);
+            persistent_vector r(*this);
+            r.take_inplace(last);
+            r.drop_inplace(first);
+            return r;
+        }
+
+        // 拼接，结果为 *this 的元素后接 rhs 的元素
+        persistent_vector concat(const persistent_vector& rhs) const {
+            persistent_vector r(*this);
+            r.concat_inplace(rhs);
+            return r;
+        }
+
+        // 以当前版本为起点的可变副本
+        transient_vector<T> transient() const { return transient_vector<T>(*this); }
+
+        void swap(persistent_vector& rhs) noexcept {
+            laistl::swap(root_, rhs.root_);
+            laistl::swap(tail_, rhs.tail_);
+            laistl::swap(size_, rhs.size_);
+            laistl::swap(shift_, rhs.shift_);
+        }
+
+    private:
+        // 就地修改操作，只修改引用计数为 1 的路径上的节点，其余节点先复制
+        void set_inplace(size_type n, const value_type& value);
+        void push_back_inplace(const value_type& value);
+        void take_inplace(size_type n);
+        void drop_inplace(size_type n);
+        void concat_inplace(const persistent_vector& rhs);
+        void reset() noexcept;
+
+    private:
+        // helper functions
+        size_type tail_count() const noexcept { return tail_ ? tail_->count : 0; }
+        size_type tree_size()  const noexcept { return size_ - tail_count(); }
+
+        // 高度为 shift 的节点最多容纳的元素数
+        static size_type capacity_at(size_type shift) noexcept { return size_type(1) << (shift + branch_bits); }
+
+        template <class Node>
+        static Node* retain(Node* n) noexcept {
+            if (n != nullptr) {
+                n->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+            return n;
+        }
+        static void release(node_base* n, size_type shift) noexcept;
+
+        static bool unique(const node_base* n) noexcept {
+            return n->refs.load(std::memory_order_acquire) == 1;
+        }
+
+        static leaf_node*  new_leaf();
+        static inner_node* new_inner();
+        static leaf_node*  copy_leaf(const leaf_node* n, size_type first, size_type last);
+        static inner_node* copy_inner(const inner_node* n);
+
+        static size_type subtree_size(const node_base* n, size_type shift) noexcept;
+        static void fix_sizes(inner_node* n, size_type shift) noexcept;
+        static void append_child(inner_node* n, node_base* c, size_type shift) noexcept;
+        static void replace_child(inner_node* n, size_type j, node_base* c, size_type shift) noexcept;
+        static size_type locate(const inner_node* n, size_type shift, size_type& i) noexcept;
+
+        const T* leaf_for(size_type n, size_type& start) const noexcept;
+        const leaf_node* tree_leaf_for(size_type n, size_type& start) const noexcept;
+
+        static node_base* set_in(node_base* n, size_type shift, size_type i, const value_type& value, bool uniq);
+        static node_base* push_leaf(node_base* n, size_type shift, leaf_node* leaf, bool uniq);
+        static node_base* new_path(node_base* n, size_type from_shift, size_type to_shift);
+        void push_tail();
+        void collapse_root() noexcept;
+
+        static node_base* take_tree(node_base* n, size_type shift, size_type k);
+        static node_base* drop_tree(node_base* n, size_type shift, size_type d);
+
+        static inner_node* concat_sub(node_base* l, size_type sl, node_base* r, size_type sr);
+        static inner_node* rebalance(inner_node* l, inner_node* mid, inner_node* r, size_type shift);
+        static node_base*  gather(node_base* const* all, size_type n_all, size_type& src, size_type& off,
+                                  size_type want, size_type shift);
+    };
+
+    /*****************************************************************************************/
+    // 迭代器：随机访问，缓存当前叶节点，顺序遍历时每 32 个元素才查找一次
+    template <class T>
+    class persistent_vector<T>::const_iterator
+        : public laistl::iterator<laistl::random_access_iterator_tag, T, ptrdiff_t, const T*, const T&> {
+    private:
+        const persistent_vector*    vec_;
+        size_type                   idx_;
+        mutable const T*            leaf_;
+        mutable size_type           leaf_start_;
+        mutable size_type           leaf_end_;
+
+    public:
+        using self = const_iterator;
+
+        const_iterator() : vec_(nullptr), idx_(0), leaf_(nullptr), leaf_start_(0), leaf_end_(0) {}
+        const_iterator(const persistent_vector* v, size_type i)
+            : vec_(v), idx_(i), leaf_(nullptr), leaf_start_(0), leaf_end_(0) {}
+
+        const T& operator*() const { return *element(); }
+        const T* operator->() const { return element(); }
+        const T& operator[](difference_type n) const { return (*vec_)[idx_ + n]; }
+
+        self& operator++() { ++idx_; return *this; }
+        self operator++(int) { self tmp = *this; ++idx_; return tmp; }
+        self& operator--() { --idx_; return *this; }
+        self operator--(int) { self tmp = *this; --idx_; return tmp; }
+
+        self& operator+=(difference_type n) { idx_ += n; return *this; }
+        self& operator-=(difference_type n) { idx_ -= n; return *this; }
+        self operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+        self operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+        difference_type operator-(const self& rhs) const {
+            return static_cast<difference_type>(idx_) - static_cast<difference_type>(rhs.idx_);
+        }
+
+        bool operator==(const self& rhs) const { return idx_ == rhs.idx_; }
+        bool operator!=(const self& rhs) const { return idx_ != rhs.idx_; }
+        bool operator<(const self& rhs) const { return idx_ < rhs.idx_; }
+        bool operator>(const self& rhs) const { return rhs < *this; }
+        bool operator<=(const self& rhs) const { return !(rhs < *this); }
+        bool operator>=(const self& rhs) const { return !(*this < rhs); }
+
+    private:
+        const T* element() const {
+            if (leaf_ == nullptr || idx_ < leaf_start_ || idx_ >= leaf_end_) {
+                const size_type ts = vec_->tree_size();
+                if (idx_ >= ts) {
+                    leaf_ = vec_->tail_->values();
+                    leaf_start_ = ts;
+                    leaf_end_ = vec_->size_;
+                } else {
+                    const leaf_node* leaf = vec_->tree_leaf_for(idx_, leaf_start_);
+                    leaf_ = leaf->values();
+                    leaf_end_ = leaf_start_ + leaf->count;
+                }
+            }
+            return leaf_ + (idx_ - leaf_start_);
+        }
+    };
+
+    /*****************************************************************************************/
+    // 模板类：transient_vector
+    // persistent_vector 的可变版本，用于批量修改：第一次修改某条路径时复制共享节点，
+    // 之后对这些新节点的修改就地进行；persistent() 取出结果并清空 transient_vector
+    template <class T>
+    class transient_vector {
+    public:
+        typedef typename persistent_vector<T>::value_type       value_type;
+        typedef typename persistent_vector<T>::const_reference  const_reference;
+        typedef typename persistent_vector<T>::size_type        size_type;
+        typedef typename persistent_vector<T>::const_iterator   const_iterator;
+
+    private:
+        persistent_vector<T> vec_;
+
+    public:
+        transient_vector() noexcept {}
+        explicit transient_vector(const persistent_vector<T>& v) noexcept : vec_(v) {}
+
+        const_iterator begin() const noexcept { return vec_.begin(); }
+        const_iterator end()   const noexcept { return vec_.end(); }
+
+        bool      empty() const noexcept { return vec_.empty(); }
+        size_type size()  const noexcept { return vec_.size(); }
+        const_reference operator[](size_type n) const { return vec_[n]; }
+
+        void set(size_type n, const value_type& value) {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "transient_vector<T>::set() subscript out of range");
+            vec_.set_inplace(n, value);
+        }
+        void push_back(const value_type& value) { vec_.push_back_inplace(value); }
+        void pop_back() {
+            MYSTL_CHECK_FAST(!empty());
+            vec_.take_inplace(size() - 1);
+        }
+        void take(size_type n) { vec_.take_inplace(n); }
+        void drop(size_type n) { vec_.drop_inplace(n); }
+        void append(const persistent_vector<T>& rhs) { vec_.concat_inplace(rhs); }
+
+        // 取出结果，之后 transient_vector 为空
+        persistent_vector<T> persistent() { return laistl::move(vec_); }
+    };
+
+    /*****************************************************************************************/
+
+    // 静态常量的定义，C++11 中按引用使用时需要
+    template <class T>
+    constexpr typename persistent_vector<T>::size_type persistent_vector<T>::branch_bits;
+
+    template <class T>
+    constexpr typename persistent_vector<T>::size_type persistent_vector<T>::branch;
+
+    // 引用计数减为 0 时递归释放子树
+    template <class T>
+    void persistent_vector<T>::release(node_base* n, size_type shift) noexcept {
+        if (n == nullptr || n->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        if (shift == 0) {
+            leaf_node* leaf = static_cast<leaf_node*>(n);
+            laistl::destroy(leaf->values(), leaf->values() + leaf->count);
+            leaf_allocator::deallocate(leaf, 1);
+        } else {
+            inner_node* in = static_cast<inner_node*>(n);
+            for (size_type j = 0; j < in->count; ++j) {
+                release(in->child[j], shift - branch_bits);
+            }
+            inner_allocator::deallocate(in, 1);
+        }
+    }
+
+    template <class T>
+    void persistent_vector<T>::reset() noexcept {
+        release(root_, shift_);
+        release(tail_, 0);
+        root_ = nullptr;
+        tail_ = nullptr;
+        size_ = 0;
+        shift_ = 0;
+    }
+
+    template <class T>
+    typename persistent_vector<T>::leaf_node* persistent_vector<T>::new_leaf() {
+        leaf_node* n = leaf_allocator::allocate(1);
+        ::new ((void*)&n->refs) std::atomic<size_type>(1);
+        n->count = 0;
+        return n;
+    }
+
+    template <class T>
+    typename persistent_vector<T>::inner_node* persistent_vector<T>::new_inner() {
+        inner_node* n = inner_allocator::allocate(1);
+        ::new ((void*)&n->refs) std::atomic<size_type>(1);
+        n->count = 0;
+        n->relaxed = false;
+        return n;
+    }
+
+    // 复制叶节点中 [first, last) 的元素
+    template <class T>
+    typename persistent_vector<T>::leaf_node*
+    persistent_vector<T>::copy_leaf(const leaf_node* n, size_type first, size_type last) {
+        leaf_node* r = new_leaf();
+        MYSTL_TRY {
+            for (; first != last; ++first, ++r->count) {
+                laistl::construct(r->values() + r->count, n->values()[first]);
+            }
+        }
+        MYSTL_CATCH_ALL {
+            release(r, 0);
+            MYSTL_RETHROW;
+        }
+        return r;
+    }
+
+    template <class T>
+    typename persistent_vector<T>::inner_node* persistent_vector<T>::copy_inner(const inner_node* n) {
+        inner_node* r = new_inner();
+        r->count = n->count;
+        r->relaxed = n->relaxed;
+        for (size_type j = 0; j < n->count; ++j) {
+            r->child[j] = retain(n->child[j]);
+            r->sizes[j] = n->sizes[j];
+        }
+        return r;
+    }
+
+    // 子树中的元素数，平衡节点只需沿最右路径计算
+    template <class T>
+    typename persistent_vector<T>::size_type
+    persistent_vector<T>::subtree_size(const node_base* n, size_type shift) noexcept {
+        size_type total = 0;
+        while (shift != 0) {
+            const inner_node* in = static_cast<const inner_node*>(n);
+            if (in->relaxed) {
+                return total + in->sizes[in->count - 1];
+            }
+            total += (in->count - 1) << shift;
+            n = in->child[in->count - 1];
+            shift -= branch_bits;
+        }
+        return total + n->count;
+    }
+
+    // 重新计算前缀和表；除最后一个子节点外都满时节点是平衡的，不需要前缀和表
+    template <class T>
+    void persistent_vector<T>::fix_sizes(inner_node* n, size_type shift) noexcept {
+        const size_type child_shift = shift - branch_bits;
+        const size_type full = capacity_at(child_shift);
+        size_type total = 0;
+        bool balanced = true;
+        for (size_type j = 0; j < n->count; ++j) {
+            const size_type s = subtree_size(n->child[j], child_shift);
+            if (j + 1 < n->count && s != full) {
+                balanced = false;
+            }
+            total += s;
+            n->sizes[j] = total;
+        }
+        n->relaxed = !balanced;
+    }
+
+    // 在节点末尾追加子节点，前一个子节点不满时转为宽松节点
+    template <class T>
+    void persistent_vector<T>::append_child(inner_node* n, node_base* c, size_type shift) noexcept {
+        const size_type child_shift = shift - branch_bits;
+        MYSTL_DEBUG(n->count < branch);
+        if (!n->relaxed && n->count != 0 &&
+            subtree_size(n->child[n->count - 1], child_shift) != capacity_at(child_shift)) {
+            n->child[n->count++] = c;
+            fix_sizes(n, shift);
+            n->relaxed = true;
+            return;
+        }
+        if (n->relaxed) {
+            n->sizes[n->count] = (n->count ? n->sizes[n->count - 1] : 0) + subtree_size(c, child_shift);
+        }
+        n->child[n->count++] = c;
+    }
+
+    // 替换第 j 个子节点并释放旧节点
+    template <class T>
+    void persistent_vector<T>::replace_child(inner_node* n, size_type j, node_base* c,
+                                             size_type shift) noexcept {
+        if (n->child[j] != c) {
+            release(n->child[j], shift - branch_bits);
+            n->child[j] = c;
+        }
+    }
+
+    // 查找下标 i 所在的子节点，返回子节点序号并把 i 改为子树内的下标
+    template <class T>
+    typename persistent_vector<T>::size_type
+    persistent_vector<T>::locate(const inner_node* n, size_type shift, size_type& i) noexcept {
+        if (!n->relaxed) {
+            const size_type j = i >> shift;
+            i -= j << shift;
+            return j;
+        }
+        // 宽松节点中第 j 个子节点至多包含 capacity 个元素，所以从 i >> shift 开始向后找
+        size_type j = i >> shift;
+        while (n->sizes[j] <= i) {
+            ++j;
+        }
+        if (j != 0) {
+            i -= n->sizes[j - 1];
+        }
+        return j;
+    }
+
+    // 返回下标 n 所在叶节点的元素数组，start 为叶节点第一个元素的下标
+    template <class T>
+    const T* persistent_vector<T>::leaf_for(size_type n, size_type& start) const noexcept {
+        const size_type ts = tree_size();
+        if (n >= ts) {
+            start = ts;
+            return tail_->values();
+        }
+        return tree_leaf_for(n, start)->values();
+    }
+
+    template <class T>
+    const typename persistent_vector<T>::leaf_node*
+    persistent_vector<T>::tree_leaf_for(size_type n, size_type& start) const noexcept {
+        const node_base* node = root_;
+        size_type i = n;
+        for (size_type shift = shift_; shift != 0; shift -= branch_bits) {
+            const inner_node* in = static_cast<const inner_node*>(node);
+            node = in->child[locate(in, shift, i)];
+        }
+        start = n - i;
+        return static_cast<const leaf_node*>(node);
+    }
+
+    // set_in: 修改子树中下标 i 的元素，返回修改后的子树根；uniq 表示从树根到 n 的路径都未被共享
+    template <class T>
+    typename persistent_vector<T>::node_base*
+    persistent_vector<T>::set_in(node_base* n, size_type shift, size_type i,
+                                 const value_type& value, bool uniq) {
+        uniq = uniq && unique(n);
+        if (shift == 0) {
+            leaf_node* leaf = uniq ? static_cast<leaf_node*>(n)
+                                   : copy_leaf(static_cast<leaf_node*>(n), 0, n->count);
+            leaf->values()[i] = value;
+            return leaf;
+        }
+        inner_node* in = static_cast<inner_node*>(n);
+        const size_type j = locate(in, shift, i);
+        node_base* c = set_in(in->child[j], shift - branch_bits, i, value, uniq);
+        inner_node* r = uniq ? in : copy_inner(in);
+        replace_child(r, j, c, shift);
+        return r;
+    }
+
+    // push_leaf: 把叶节点追加到子树的最右侧，子树已满时返回 nullptr 且不做任何修改
+    template <class T>
+    typename persistent_vector<T>::node_base*
+    persistent_vector<T>::push_leaf(node_base* n, size_type shift, leaf_node* leaf, bool uniq) {
+        uniq = uniq && unique(n);
+        inner_node* in = static_cast<inner_node*>(n);
+        if (shift > branch_bits) {
+            const size_type last = in->count - 1;
+            node_base* c = push_leaf(in->child[last], shift - branch_bits, leaf, uniq);
+            if (c != nullptr) {
+                inner_node* r = uniq ? in : copy_inner(in);
+                replace_child(r, last, c, shift);
+                if (r->relaxed) {
+                    r->sizes[last] += leaf->count;
+                }
+                return r;
+            }
+        }
+        if (in->count == branch) {
+            return nullptr;
+        }
+        inner_node* r = uniq ? in : copy_inner(in);
+        append_child(r, new_path(leaf, 0, shift - branch_bits), shift);
+        return r;
+    }
+
+    // new_path: 用单子节点的内部节点把 n 从 from_shift 包装到 to_shift 高度
+    template <class T>
+    typename persistent_vector<T>::node_base*
+    persistent_vector<T>::new_path(node_base* n, size_type from_shift, size_type to_shift) {
+        for (size_type shift = from_shift + branch_bits; shift <= to_shift; shift += branch_bits) {
+            inner_node* p = new_inner();
+            p->child[0] = n;
+            p->count = 1;
+            p->sizes[0] = subtree_size(n, shift - branch_bits);
+            n = p;
+        }
+        return n;
+    }
+
+    // push_tail: 把 tail 并入树中，tail 置空
+    template <class T>
+    void persistent_vector<T>::push_tail() {
+        leaf_node* leaf = tail_;
+        if (root_ == nullptr) {
+            root_ = leaf;
+            shift_ = 0;
+            tail_ = nullptr;
+            return;
+        }
+        if (shift_ != 0) {
+            node_base* r = push_leaf(root_, shift_, leaf, true);
+            if (r != nullptr) {
+                if (r != root_) {
+                    release(root_, shift_);
+                }
+                root_ = r;
+                tail_ = nullptr;
+                return;
+            }
+        }
+        // 根已满，树长高一层
+        inner_node* r = new_inner();
+        r->child[0] = root_;
+        r->count = 1;
+        append_child(r, new_path(leaf, 0, shift_), shift_ + branch_bits);
+        root_ = r;
+        shift_ += branch_bits;
+        tail_ = nullptr;
+    }
+
+    // collapse_root: 去掉只有一个子节点的根
+    template <class T>
+    void persistent_vector<T>::collapse_root() noexcept {
+        while (shift_ != 0 && root_->count == 1) {
+            node_base* c = retain(static_cast<inner_node*>(root_)->child[0]);
+            release(root_, shift_);
+            root_ = c;
+            shift_ -= branch_bits;
+        }
+    }
+
+    // set_inplace
+    template <class T>
+    void persistent_vector<T>::set_inplace(size_type n, const value_type& value) {
+        MYSTL_CHECK_FAST(n < size_);
+        const size_type ts = tree_size();
+        if (n >= ts) {
+            if (!unique(tail_)) {
+                leaf_node* t = copy_leaf(tail_, 0, tail_->count);
+                release(tail_, 0);
+                tail_ = t;
+            }
+            tail_->values()[n - ts] = value;
+            return;
+        }
+        node_base* r = set_in(root_, shift_, n, value, true);
+        if (r != root_) {
+            release(root_, shift_);
+            root_ = r;
+        }
+    }
+
+    // push_back_inplace
+    template <class T>
+    void persistent_vector<T>::push_back_inplace(const value_type& value) {
+        if (tail_ != nullptr && tail_->count == branch) {
+            push_tail();
+        }
+        if (tail_ == nullptr) {
+            tail_ = new_leaf();
+        } else if (!unique(tail_)) {
+            leaf_node* t = copy_leaf(tail_, 0, tail_->count);
+            release(tail_, 0);
+            tail_ = t;
+        }
+        laistl::construct(tail_->values() + tail_->count, value);
+        ++tail_->count;
+        ++size_;
+    }
+
+    // take_tree: 子树的前 k 个元素，k 落在叶节点边界上
+    template <class T>
+    typename persistent_vector<T>::node_base*
+    persistent_vector<T>::take_tree(node_base* n, size_type shift, size_type k) {
+        if (k == subtree_size(n, shift)) {
+            return retain(n);
+        }
+        MYSTL_DEBUG(shift != 0);
+        inner_node* in = static_cast<inner_node*>(n);
+        size_type i = k - 1;
+        const size_type j = locate(in, shift, i);
+        inner_node* r = new_inner();
+        for (size_type c = 0; c < j; ++c) {
+            r->child[c] = retain(in->child[c]);
+        }
+        r->count = j;
+        r->child[j] = take_tree(in->child[j], shift - branch_bits, i + 1);
+        r->count = j + 1;
+        fix_sizes(r, shift);
+        return r;
+    }
+
+    // take_inplace: 保留前 n 个元素，结果中下标 n - 1 所在的叶节点成为新的 tail
+    template <class T>
+    void persistent_vector<T>::take_inplace(size_type n) {
+        MYSTL_DEBUG(n <= size_);
+        if (n >= size_) {
+            return;
+        }
+        if (n == 0) {
+            reset();
+            return;
+        }
+        const size_type ts = tree_size();
+        if (n >= ts) {
+            if (unique(tail_)) {
+                laistl::destroy(tail_->values() + (n - ts), tail_->values() + tail_->count);
+                tail_->count = n - ts;
+            } else {
+                leaf_node* t = copy_leaf(tail_, 0, n - ts);
+                release(tail_, 0);
+                tail_ = t;
+            }
+            size_ = n;
+            return;
+        }
+        size_type start;
+        const leaf_node* leaf = tree_leaf_for(n - 1, start);
+        leaf_node* t = copy_leaf(leaf, 0, n - start);
+        node_base* r = start == 0 ? nullptr : take_tree(root_, shift_, start);
+        release(root_, shift_);
+        release(tail_, 0);
+        root_ = r;
+        tail_ = t;
+        size_ = n;
+        if (root_ == nullptr) {
+            shift_ = 0;
+        } else {
+            collapse_root();
+        }
+    }
+
+    // drop_tree: 去掉子树的前 d 个元素，0 < d < 子树大小
+    template <class T>
+    typename persistent_vector<T>::node_base*
+    persistent_vector<T>::drop_tree(node_base* n, size_type shift, size_type d) {
+        if (shift == 0) {
+            return copy_leaf(static_cast<leaf_node*>(n), d, n->count);
+        }
+        inner_node* in = static_cast<inner_node*>(n);
+        size_type i = d;
+        const size_type j = locate(in, shift, i);
+        inner_node* r = new_inner();
+        r->child[0] = i == 0 ? retain(in->child[j]) : drop_tree(in->child[j], shift - branch_bits, i);
+        r->count = 1;
+        for (size_type c = j + 1; c < in->count; ++c) {
+            r->child[r->count++] = retain(in->child[c]);
+        }
+        fix_sizes(r, shift);
+        return r;
+    }
+
+    // drop_inplace: 去掉前 n 个元素
+    template <class T>
+    void persistent_vector<T>::drop_inplace(size_type n) {
+        MYSTL_DEBUG(n <= size_);
+        if (n == 0) {
+            return;
+        }
+        if (n >= size_) {
+            reset();
+            return;
+        }
+        const size_type ts = tree_size();
+        if (n >= ts) {
+            leaf_node* t = copy_leaf(tail_, n - ts, tail_->count);
+            reset();
+            tail_ = t;
+            size_ = t->count;
+            return;
+        }
+        node_base* r = drop_tree(root_, shift_, n);
+        release(root_, shift_);
+        root_ = r;
+        size_ -= n;
+        collapse_root();
+    }
+
+    // concat_inplace: 先把 tail 并入树中，再按 RRB 算法拼接两棵树，rhs 的 tail 成为新的 tail
+    template <class T>
+    void persistent_vector<T>::concat_inplace(const persistent_vector& rhs) {
+        if (rhs.empty()) {
+            return;
+        }
+        if (empty()) {
+            *this = rhs;
+            return;
+        }
+        if (rhs.root_ == nullptr) {
+            for (size_type i = 0; i < rhs.tail_->count; ++i) {
+                push_back_inplace(rhs.tail_->values()[i]);
+            }
+            return;
+        }
+        if (tail_ != nullptr) {
+            if (tail_->count != 0) {
+                push_tail();
+            } else {
+                release(tail_, 0);
+                tail_ = nullptr;
+            }
+        }
+        inner_node* top = concat_sub(root_, shift_, rhs.root_, rhs.shift_);
+        release(root_, shift_);
+        const size_type shift = laistl::max(shift_, rhs.shift_);
+        if (top->count == 1) {
+            root_ = retain(top->child[0]);
+            shift_ = shift;
+            release(top, shift + branch_bits);
+        } else {
+            root_ = top;
+            shift_ = shift + branch_bits;
+        }
+        tail_ = retain(rhs.tail_);
+        size_ += rhs.size_;
+    }
+
+    // concat_sub: 拼接高度为 sl 的 l 与高度为 sr 的 r，
+    // 返回高度为 max(sl, sr) + 1 层、含 1 到 2 个子节点的新节点，不改变 l 和 r
+    template <class T>
+    typename persistent_vector<T>::inner_node*
+    persistent_vector<T>::concat_sub(node_base* l, size_type sl, node_base* r, size_type sr) {
+        if (sl > sr) {
+            inner_node* li = static_cast<inner_node*>(l);
+            inner_node* mid = concat_sub(li->child[li->count - 1], sl - branch_bits, r, sr);
+            return rebalance(li, mid, nullptr, sl);
+        }
+        if (sl < sr) {
+            inner_node* ri = static_cast<inner_node*>(r);
+            inner_node* mid = concat_sub(l, sl, ri->child[0], sr - branch_bits);
+            return rebalance(nullptr, mid, ri, sr);
+        }
+        if (sl == 0) {
+            // 两个叶节点，能放进一个叶节点时合并
+            inner_node* top = new_inner();
+            const leaf_node* a = static_cast<const leaf_node*>(l);
+            const leaf_node* b = static_cast<const leaf_node*>(r);
+            if (a->count + b->count <= branch) {
+                leaf_node* m = copy_leaf(a, 0, a->count);
+                MYSTL_TRY {
+                    for (size_type i = 0; i < b->count; ++i, ++m->count) {
+                        laistl::construct(m->values() + m->count, b->values()[i]);
+                    }
+                }
+                MYSTL_CATCH_ALL {
+                    release(m, 0);
+                    release(top, branch_bits);
+                    MYSTL_RETHROW;
+                }
+                top->child[top->count++] = m;
+            } else {
+                top->child[top->count++] = retain(l);
+                top->child[top->count++] = retain(r);
+            }
+            fix_sizes(top, branch_bits);
+            return top;
+        }
+        inner_node* li = static_cast<inner_node*>(l);
+        inner_node* ri = static_cast<inner_node*>(r);
+        inner_node* mid = concat_sub(li->child[li->count - 1], sl - branch_bits, ri->child[0], sr - branch_bits);
+        return rebalance(li, mid, ri, sl);
+    }
+
+    // rebalance: 把 l（除最后一个子节点）、mid 的子节点、r（除第一个子节点）重新分配，
+    // 使子节点数不超过最优值加 2，返回高度为 shift + 1 层的新节点；释放 mid
+    template <class T>
+    typename persistent_vector<T>::inner_node*
+    persistent_vector<T>::rebalance(inner_node* l, inner_node* mid, inner_node* r, size_type shift) {
+        static constexpr size_type extras = 2;
+        node_base* all[3 * branch];
+        size_type n = 0;
+        if (l != nullptr) {
+            for (size_type j = 0; j + 1 < l->count; ++j) all[n++] = l->child[j];
+        }
+        for (size_type j = 0; j < mid->count; ++j) all[n++] = mid->child[j];
+        if (r != nullptr) {
+            for (size_type j = 1; j < r->count; ++j) all[n++] = r->child[j];
+        }
+
+        // 计算分配方案：子节点数超过最优值加 extras 时，把较空的节点并入后续节点
+        size_type szs[3 * branch];
+        size_type total = 0;
+        for (size_type j = 0; j < n; ++j) {
+            szs[j] = all[j]->count;
+            total += szs[j];
+        }
+        const size_type opt = (total + branch - 1) / branch;
+        size_type m = n;
+        while (m > opt + extras) {
+            size_type i = 0;
+            while (szs[i] > branch - extras / 2) {
+                ++i;
+            }
+            size_type rem = szs[i];
+            while (rem > 0) {
+                const size_type min_size = laistl::min(rem + szs[i + 1], branch);
+                szs[i] = min_size;
+                rem = rem + szs[i + 1] - min_size;
+                ++i;
+            }
+            for (size_type j = i; j + 1 < m; ++j) {
+                szs[j] = szs[j + 1];
+            }
+            --m;
+        }
+
+        // 按方案构造新的子节点，大小不变的节点直接共享
+        const size_type child_shift = shift - branch_bits;
+        node_base* out[3 * branch];
+        size_type src = 0, off = 0;
+        for (size_type j = 0; j < m; ++j) {
+            out[j] = gather(all, n, src, off, szs[j], child_shift);
+        }
+        release(mid, shift);
+
+        inner_node* top = new_inner();
+        for (size_type k = 0; k < m; k += branch) {
+            inner_node* part = new_inner();
+            for (size_type j = k; j < m && j < k + branch; ++j) {
+                part->child[part->count++] = out[j];
+            }
+            fix_sizes(part, shift);
+            top->child[top->count++] = part;
+        }
+        fix_sizes(top, shift + branch_bits);
+        return top;
+    }
+
+    // gather: 从 all[src] 的第 off 项开始依次取出 want 项，组成一个高度为 shift 的新节点
+    template <class T>
+    typename persistent_vector<T>::node_base*
+    persistent_vector<T>::gather(node_base* const* all, size_type n_all, size_type& src, size_type& off,
+                                 size_type want, size_type shift) {
+        if (off == 0 && all[src]->count == want) {
+            return retain(all[src++]);
+        }
+        if (shift == 0) {
+            leaf_node* r = new_leaf();
+            MYSTL_TRY {
+                while (r->count < want) {
+                    MYSTL_DEBUG(src < n_all);
+                    const leaf_node* s = static_cast<const leaf_node*>(all[src]);
+                    laistl::construct(r->values() + r->count, s->values()[off]);
+                    ++r->count;
+                    if (++off == s->count) {
+                        ++src;
+                        off = 0;
+                    }
+                }
+            }
+            MYSTL_CATCH_ALL {
+                release(r, 0);
+                MYSTL_RETHROW;
+            }
+            return r;
+        }
+        inner_node* r = new_inner();
+        while (r->count < want) {
+            MYSTL_DEBUG(src < n_all);
+            const inner_node* s = static_cast<const inner_node*>(all[src]);
+            r->child[r->count++] = retain(s->child[off]);
+            if (++off == s->count) {
+                ++src;
+                off = 0;
+            }
+        }
+        fix_sizes(r, shift);
+        return r;
+    }
+
+    // 重载比较操作符
+    template <class T>
+    bool operator==(const persistent_vector<T>& lhs, const persistent_vector<T>& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        auto i = rhs.begin();
+        for (const auto& x : lhs) {
+            if (!(x == *i++)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class T>
+    bool operator!=(const persistent_vector<T>& lhs, const persistent_vector<T>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // 重载 swap
+    template <class T>
+    void swap(persistent_vector<T>& lhs, persistent_vector<T>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
+} /* namespace laistl */
+
+#endif /* _PERSISTENT_VECTOR_H */
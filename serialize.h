@@ -0,0 +1,297 @@
+#ifndef _SERIALIZE_H
+#define _SERIALIZE_H
+
+// vector 与 vector<pair> 的二进制序列化
+// 元素可按位复制时整块写出，读回时直接写入默认初始化的 vector 缓冲区；也可以在映射的缓冲区上原地查看
+// 格式依赖本机字节序和类型布局，只用于同构机器之间的进程间传输
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <errno.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "exceptdef.h"
+#include "span.h"
+#include "type_traits.h"
+#include "util.h"
+#include "vector.h"
+
+namespace laistl {
+    // is_bitwise_serializable: 可按位复制的类型，以及成员均可按位复制的 pair
+    template <class T>
+    struct is_bitwise_serializable : m_bool_constant<std::is_trivially_copyable<T>::value> {};
+
+    template <class K, class V>
+    struct is_bitwise_serializable<laistl::pair<K, V>>
+        : m_bool_constant<is_bitwise_serializable<K>::value && is_bitwise_serializable<V>::value> {};
+
+    // 序列化数据的种类
+    enum class serial_kind : uint16_t {
+        flat = 1,       // vector<T>: [header][填充][T * count][填充]
+        nested = 2      // vector<vector<T>>: [header][uint64_t 长度 * count][填充][所有元素依次排列][填充]
+    };
+
+    // 头部 32 字节，映射的缓冲区按页对齐时数据区按 32 字节对齐
+    struct serial_header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t kind;
+        uint32_t elem_size;
+        uint32_t elem_align;
+        uint64_t count;
+        uint64_t reserved;
+    };
+
+    constexpr uint32_t serial_magic = 0x4c535443;  // "CTSL"
+    constexpr uint16_t serial_version = 1;
+
+    // 每条记录的总长度补齐到 8 字节，连续写入同一个流的多条记录在映射后仍然对齐
+    constexpr size_t serial_record_align = 8;
+
+    // serial_align: 元素区起点和记录总长度的对齐，取 8 字节与 alignof(T) 中的较大者
+    template <class T>
+    struct serial_align
+        : m_integral_constant<size_t, (alignof(T) > serial_record_align ? alignof(T) : serial_record_align)> {};
+
+    namespace serial_detail {
+        template <class T>
+        serial_header make_header(serial_kind kind, uint64_t count) {
+            serial_header h;
+            std::memset(&h, 0, sizeof(h));
+            h.magic = serial_magic;
+            h.version = serial_version;
+            h.kind = static_cast<uint16_t>(kind);
+            h.elem_size = static_cast<uint32_t>(sizeof(T));
+            h.elem_align = static_cast<uint32_t>(alignof(T));
+            h.count = count;
+            return h;
+        }
+
+        template <class T>
+        void check_header(const serial_header& h, serial_kind kind) {
+            THROW_RUNTIME_ERROR_IF(h.magic != serial_magic, "serialize: bad magic");
+            THROW_RUNTIME_ERROR_IF(h.version != serial_version, "serialize: unsupported version");
+            THROW_RUNTIME_ERROR_IF(h.kind != static_cast<uint16_t>(kind), "serialize: kind mismatch");
+            THROW_RUNTIME_ERROR_IF(h.elem_size != sizeof(T) || h.elem_align != alignof(T),
+                                   "serialize: element layout mismatch");
+        }
+
+        // 写出全部 iovec，处理部分写入和 IOV_MAX 限制
+        inline void write_all(int fd, struct iovec* iov, size_t cnt) {
+        #ifdef IOV_MAX
+            const size_t max_iov = IOV_MAX;
+        #else
+            const size_t max_iov = 1024;
+        #endif
+            while (cnt != 0) {
+                const size_t batch = cnt < max_iov ? cnt : max_iov;
+                const ssize_t r = ::writev(fd, iov, static_cast<int>(batch));
+                if (r < 0 && errno == EINTR) {
+                    continue;
+                }
+                THROW_RUNTIME_ERROR_IF(r < 0, "serialize: writev failed");
+                size_t done = static_cast<size_t>(r);
+                while (cnt != 0 && done >= iov->iov_len) {
+                    done -= iov->iov_len;
+                    ++iov;
+                    --cnt;
+                }
+                if (cnt != 0) {
+                    iov->iov_base = static_cast<char*>(iov->iov_base) + done;
+                    iov->iov_len -= done;
+                }
+            }
+        }
+
+        // 读满 n 个字节，提前遇到文件结束时抛出异常
+        inline void read_all(int fd, void* buf, size_t n) {
+            char* p = static_cast<char*>(buf);
+            while (n != 0) {
+                const ssize_t r = ::read(fd, p, n);
+                if (r < 0 && errno == EINTR) {
+                    continue;
+                }
+                THROW_RUNTIME_ERROR_IF(r < 0, "serialize: read failed");
+                THROW_RUNTIME_ERROR_IF(r == 0, "serialize: unexpected end of file");
+                p += r;
+                n -= static_cast<size_t>(r);
+            }
+        }
+
+        // 记录内偏移 n 补齐到 T 的记录对齐所需的填充字节数
+        template <class T>
+        size_t pad_of(size_t n) {
+            return (serial_align<T>::value - n % serial_align<T>::value) % serial_align<T>::value;
+        }
+
+        // 跳过记录内偏移 n 之后的填充字节
+        template <class T>
+        void read_pad(int fd, size_t n) {
+            char pad[serial_align<T>::value];
+            read_all(fd, pad, pad_of<T>(n));
+        }
+
+        inline struct iovec make_iov(const void* p, size_t n) {
+            struct iovec v;
+            v.iov_base = const_cast<void*>(p);
+            v.iov_len = n;
+            return v;
+        }
+
+        // 在缓冲区中取出 n 个 T，检查长度和对齐
+        template <class T>
+        const T* take(const char*& cur, const char* last, size_t n) {
+            THROW_RUNTIME_ERROR_IF(static_cast<size_t>(last - cur) / sizeof(T) < n,
+                                   "serialize: buffer too short");
+            THROW_RUNTIME_ERROR_IF(reinterpret_cast<uintptr_t>(cur) % alignof(T) != 0,
+                                   "serialize: misaligned buffer");
+            const T* p = reinterpret_cast<const T*>(cur);
+            cur += n * sizeof(T);
+            return p;
+        }
+
+        // 跳过填充字节，填充按记录起点 first 计算
+        template <class T>
+        void skip_pad(const char*& cur, const char* last, const char* first) {
+            const size_t pad = pad_of<T>(static_cast<size_t>(cur - first));
+            THROW_RUNTIME_ERROR_IF(static_cast<size_t>(last - cur) < pad, "serialize: buffer too short");
+            cur += pad;
+        }
+    } /* namespace serial_detail */
+
+    /*****************************************************************************************/
+
+    // write_to: 头部和元素数据用一次 writev 写出
+    template <class T, class G>
+    void write_to(int fd, const vector<T, G>& v) {
+        static_assert(is_bitwise_serializable<T>::value, "write_to requires a bitwise serializable T");
+        static const char zeros[serial_align<T>::value] = {};
+        serial_header h = serial_detail::make_header<T>(serial_kind::flat, v.size());
+        const size_t head_pad = serial_detail::pad_of<T>(sizeof(h));
+        const size_t bytes = v.size() * sizeof(T);
+        struct iovec iov[4] = {
+            serial_detail::make_iov(&h, sizeof(h)),
+            serial_detail::make_iov(zeros, head_pad),
+            serial_detail::make_iov(v.data(), bytes),
+            serial_detail::make_iov(zeros, serial_detail::pad_of<T>(sizeof(h) + head_pad + bytes))
+        };
+        serial_detail::write_all(fd, iov, 4);
+    }
+
+    // write_to: 嵌套 vector，长度表和每个内层 vector 各占一个 iovec，不做中间拷贝
+    // 长度表之后补齐到 serial_align<T>，元素区起点满足 T 的对齐
+    template <class T, class G1, class G2>
+    void write_to(int fd, const vector<vector<T, G1>, G2>& v) {
+        static_assert(is_bitwise_serializable<T>::value, "write_to requires a bitwise serializable T");
+        static const char zeros[serial_align<T>::value] = {};
+        serial_header h = serial_detail::make_header<T>(serial_kind::nested, v.size());
+        size_t bytes = sizeof(h) + v.size() * sizeof(uint64_t);
+        vector<uint64_t> lens;
+        lens.reserve(v.size());
+        vector<struct iovec> iov;
+        iov.reserve(v.size() + 4);
+        iov.push_back(serial_detail::make_iov(&h, sizeof(h)));
+        for (const auto& inner : v) {
+            lens.push_back(inner.size());
+        }
+        if (!lens.empty()) {
+            iov.push_back(serial_detail::make_iov(lens.data(), lens.size() * sizeof(uint64_t)));
+        }
+        iov.push_back(serial_detail::make_iov(zeros, serial_detail::pad_of<T>(bytes)));
+        bytes += serial_detail::pad_of<T>(bytes);
+        for (const auto& inner : v) {
+            if (!inner.empty()) {
+                iov.push_back(serial_detail::make_iov(inner.data(), inner.size() * sizeof(T)));
+                bytes += inner.size() * sizeof(T);
+            }
+        }
+        iov.push_back(serial_detail::make_iov(zeros, serial_detail::pad_of<T>(bytes)));
+        serial_detail::write_all(fd, iov.data(), iov.size());
+    }
+
+    // read_from: 校验头部后一次 read 直接读入 vector 缓冲区，原有内容被替换
+    template <class T, class G>
+    void read_from(int fd, vector<T, G>& v) {
+        static_assert(is_bitwise_serializable<T>::value, "read_from requires a bitwise serializable T");
+        serial_header h;
+        serial_detail::read_all(fd, &h, sizeof(h));
+        serial_detail::check_header<T>(h, serial_kind::flat);
+        THROW_LENGTH_ERROR_IF(h.count > v.max_size(), "serialize: element count too big");
+        serial_detail::read_pad<T>(fd, sizeof(h));
+        v.resize_default_init(static_cast<size_t>(h.count));
+        serial_detail::read_all(fd, v.data(), v.size() * sizeof(T));
+        serial_detail::read_pad<T>(fd, sizeof(h) + serial_detail::pad_of<T>(sizeof(h)) + v.size() * sizeof(T));
+    }
+
+    template <class T, class G1, class G2>
+    void read_from(int fd, vector<vector<T, G1>, G2>& v) {
+        static_assert(is_bitwise_serializable<T>::value, "read_from requires a bitwise serializable T");
+        serial_header h;
+        serial_detail::read_all(fd, &h, sizeof(h));
+        serial_detail::check_header<T>(h, serial_kind::nested);
+        THROW_LENGTH_ERROR_IF(h.count > v.max_size(), "serialize: element count too big");
+        vector<uint64_t> lens;
+        lens.resize_default_init(static_cast<size_t>(h.count));
+        serial_detail::read_all(fd, lens.data(), lens.size() * sizeof(uint64_t));
+        size_t bytes = sizeof(h) + lens.size() * sizeof(uint64_t);
+        serial_detail::read_pad<T>(fd, bytes);
+        bytes += serial_detail::pad_of<T>(bytes);
+        v.clear();
+        v.resize(lens.size());
+        for (size_t i = 0; i < lens.size(); ++i) {
+            THROW_LENGTH_ERROR_IF(lens[i] > v[i].max_size(), "serialize: element count too big");
+            v[i].resize_default_init(static_cast<size_t>(lens[i]));
+            serial_detail::read_all(fd, v[i].data(), v[i].size() * sizeof(T));
+            bytes += v[i].size() * sizeof(T);
+        }
+        serial_detail::read_pad<T>(fd, bytes);
+    }
+
+    // view_flat: 在映射的缓冲区上原地查看 vector<T> 的序列化结果，不复制元素
+    // 返回的 span 引用 buf，buf 须保持有效；len 为缓冲区长度，返回时 *used 为消耗的字节数
+    template <class T>
+    span<const T> view_flat(const void* buf, size_t len, size_t* used = nullptr) {
+        static_assert(is_bitwise_serializable<T>::value, "view_flat requires a bitwise serializable T");
+        const char* cur = static_cast<const char*>(buf);
+        const char* last = cur + len;
+        const serial_header& h = *serial_detail::take<serial_header>(cur, last, 1);
+        serial_detail::check_header<T>(h, serial_kind::flat);
+        serial_detail::skip_pad<T>(cur, last, static_cast<const char*>(buf));
+        const T* p = serial_detail::take<T>(cur, last, static_cast<size_t>(h.count));
+        serial_detail::skip_pad<T>(cur, last, static_cast<const char*>(buf));
+        if (used != nullptr) {
+            *used = static_cast<size_t>(cur - static_cast<const char*>(buf));
+        }
+        return span<const T>(p, static_cast<size_t>(h.count));
+    }
+
+    // view_nested: 在映射的缓冲区上查看 vector<vector<T>>，只为每个内层生成一个 span
+    template <class T>
+    vector<span<const T>> view_nested(const void* buf, size_t len, size_t* used = nullptr) {
+        static_assert(is_bitwise_serializable<T>::value, "view_nested requires a bitwise serializable T");
+        const char* cur = static_cast<const char*>(buf);
+        const char* last = cur + len;
+        const serial_header& h = *serial_detail::take<serial_header>(cur, last, 1);
+        serial_detail::check_header<T>(h, serial_kind::nested);
+        const uint64_t* lens = serial_detail::take<uint64_t>(cur, last, static_cast<size_t>(h.count));
+        serial_detail::skip_pad<T>(cur, last, static_cast<const char*>(buf));
+        vector<span<const T>> views;
+        views.reserve(static_cast<size_t>(h.count));
+        for (size_t i = 0; i < h.count; ++i) {
+            const T* p = serial_detail::take<T>(cur, last, static_cast<size_t>(lens[i]));
+            views.push_back(span<const T>(p, static_cast<size_t>(lens[i])));
+        }
+        serial_detail::skip_pad<T>(cur, last, static_cast<const char*>(buf));
+        if (used != nullptr) {
+            *used = static_cast<size_t>(cur - static_cast<const char*>(buf));
+        }
+        return views;
+    }
+
+} /* namespace laistl */
+
+#endif /* _SERIALIZE_H */
@@ -0,0 +1,141 @@
+#ifndef _SIMD_SEARCH_H
+#define _SIMD_SEARCH_H
+
+// 字节序列的向量化查找：单字节查找、字符集查找、子串查找
+// 编译目标支持 AVX2 / SSE2 时一次比较 32 / 16 个字节，否则退化为逐字节版本
+
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "util.h"
+
+namespace laistl {
+    // 返回 32 / 16 字节块与 ch 逐字节比较的结果掩码
+    #if defined(__AVX2__)
+    constexpr size_t simd_block = 32;
+
+    inline unsigned simd_eq_mask(const char* p, char ch) noexcept {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(ch))));
+    }
+    #elif defined(__SSE2__)
+    constexpr size_t simd_block = 16;
+
+    inline unsigned simd_eq_mask(const char* p, char ch) noexcept {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(ch))));
+    }
+    #endif
+
+    // 最低位 1 的位置，mask 不能为 0
+    inline size_t simd_lowest_bit(unsigned mask) noexcept {
+    #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctz(mask));
+    #else
+        size_t n = 0;
+        while ((mask & 1u) == 0) {
+            mask >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    // find_byte: 在 [first, last) 中查找 ch，找不到时返回 last
+    inline const char* find_byte(const char* first, const char* last, char ch) noexcept {
+    #if defined(__AVX2__) || defined(__SSE2__)
+        for (; static_cast<size_t>(last - first) >= simd_block; first += simd_block) {
+            const unsigned mask = simd_eq_mask(first, ch);
+            if (mask != 0) {
+                return first + simd_lowest_bit(mask);
+            }
+        }
+    #endif
+        for (; first != last; ++first) {
+            if (*first == ch) {
+                return first;
+            }
+        }
+        return last;
+    }
+
+    // find_first_of_bytes: 在 [first, last) 中查找第一个属于 [set, set + n) 的字节，找不到时返回 last
+    // 字符集较小时对每个候选字符做一次向量比较后合并掩码，较大时用 256 位查找表
+    inline const char* find_first_of_bytes(const char* first, const char* last,
+                                           const char* set, size_t n) noexcept {
+        if (n == 0) {
+            return last;
+        }
+        if (n == 1) {
+            return find_byte(first, last, set[0]);
+        }
+    #if defined(__AVX2__) || defined(__SSE2__)
+        if (n <= 8) {
+            for (; static_cast<size_t>(last - first) >= simd_block; first += simd_block) {
+                unsigned mask = 0;
+                for (size_t k = 0; k < n; ++k) {
+                    mask |= simd_eq_mask(first, set[k]);
+                }
+                if (mask != 0) {
+                    return first + simd_lowest_bit(mask);
+                }
+            }
+        }
+    #endif
+        bool table[256] = {};
+        for (size_t k = 0; k < n; ++k) {
+            table[static_cast<unsigned char>(set[k])] = true;
+        }
+        for (; first != last; ++first) {
+            if (table[static_cast<unsigned char>(*first)]) {
+                return first;
+            }
+        }
+        return last;
+    }
+
+    // search_bytes: 在 [first, last) 中查找子串 [s, s + n)，找不到时返回 last
+    // 同时比较候选位置上的首字节和尾字节，两者都相等的位置才用 memcmp 验证中间部分
+    inline const char* search_bytes(const char* first, const char* last,
+                                    const char* s, size_t n) noexcept {
+        const size_t len = static_cast<size_t>(last - first);
+        if (n == 0) {
+            return first;
+        }
+        if (n > len) {
+            return last;
+        }
+        if (n == 1) {
+            return find_byte(first, last, s[0]);
+        }
+        const char head = s[0];
+        const char tail = s[n - 1];
+        size_t i = 0;
+    #if defined(__AVX2__) || defined(__SSE2__)
+        // 块 [i, i + simd_block) 内每个起点 j 都要读 first[j + n - 1]，保证不越过 last
+        for (; i + n - 1 + simd_block <= len; i += simd_block) {
+            unsigned mask = simd_eq_mask(first + i, head) & simd_eq_mask(first + i + n - 1, tail);
+            while (mask != 0) {
+                const size_t j = i + simd_lowest_bit(mask);
+                if (std::memcmp(first + j + 1, s + 1, n - 2) == 0) {
+                    return first + j;
+                }
+                mask &= mask - 1;
+            }
+        }
+    #endif
+        for (; i + n <= len; ++i) {
+            if (first[i] == head && first[i + n - 1] == tail &&
+                std::memcmp(first + i + 1, s + 1, n - 2) == 0) {
+                return first + i;
+            }
+        }
+        return last;
+    }
+
+} /* namespace laistl */
+
+#endif /* _SIMD_SEARCH_H */
@@ -0,0 +1,210 @@
+#ifndef _SLOT_MAP_H
+#define _SLOT_MAP_H
+
+// 带代数句柄的对象池
+// 元素紧密存放在 vector 中便于遍历，外部通过句柄访问；删除时与最后一个元素交换，句柄不会失效，
+// 已删除元素的句柄通过代数（generation）检测出来
+
+#include <cstdint>
+
+#include "exceptdef.h"
+#include "util.h"
+#include "vector.h"
+
+namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
+    // slot_map 的句柄：槽位下标 + 代数
+    struct slot_handle {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    inline bool operator==(const slot_handle& lhs, const slot_handle& rhs) {
+        return lhs.index == rhs.index && lhs.generation == rhs.generation;
+    }
+
+    inline bool operator!=(const slot_handle& lhs, const slot_handle& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // 模板类：slot_map
+    // slots_[h.index] 记录元素在 values_ 中的位置，空闲槽位的 index 串成空闲链表
+    // 每次删除后槽位的代数加一，持有旧代数的句柄即为失效句柄
+    template <class T>
+    class slot_map {
+    public:
+        typedef T                                           value_type;
+        typedef T&                                          reference;
+        typedef const T&                                    const_reference;
+        typedef size_t                                      size_type;
+        typedef slot_handle                                 handle_type;
+
+        typedef typename laistl::vector<T>::iterator        iterator;
+        typedef typename laistl::vector<T>::const_iterator  const_iterator;
+
+    private:
+        struct slot {
+            uint32_t index;         // 占用时为元素在 values_ 中的位置，空闲时为下一个空闲槽位
+            uint32_t generation;
+        };
+
+        static constexpr uint32_t npos = static_cast<uint32_t>(-1);
+
+        laistl::vector<T>           values_;        // 紧密存放的元素
+        laistl::vector<uint32_t>    value_slot_;    // values_[i] 对应的槽位
+        laistl::vector<slot>        slots_;         // 槽位表
+        uint32_t                    free_head_;     // 空闲链表头
+
+    public:
+        // 构造函数
+        slot_map() : free_head_(npos) {}
+
+    public:
+        // 迭代器操作，按紧密存放的顺序遍历所有元素
+        iterator        begin()         noexcept { return values_.begin(); }
+        const_iterator  begin()   const noexcept { return values_.begin(); }
+        iterator        end()           noexcept { return values_.end(); }
+        const_iterator  end()     const noexcept { return values_.end(); }
+
+    public:
+        // 容器操作
+        bool empty()            const noexcept { return values_.empty(); }
+        size_type size()        const noexcept { return values_.size(); }
+        size_type capacity()    const noexcept { return values_.capacity(); }
+
+        void reserve(size_type n) {
+            values_.reserve(n);
+            value_slot_.reserve(n);
+            slots_.reserve(n);
+        }
+
+    public:
+        // 访问元素操作
+        bool contains(handle_type h) const noexcept {
+            return h.index < slots_.size() && slots_[h.index].generation == h.generation;
+        }
+
+        // 失效句柄返回 nullptr
+        T* find(handle_type h) noexcept {
+            return contains(h) ? values_.data() + slots_[h.index].index : nullptr;
+        }
+
+        const T* find(handle_type h) const noexcept {
+            return contains(h) ? values_.data() + slots_[h.index].index : nullptr;
+        }
+
+        reference operator[](handle_type h) {
+            MYSTL_CHECK_FAST(contains(h));
+            return values_[slots_[h.index].index];
+        }
+
+        const_reference operator[](handle_type h) const {
+            MYSTL_CHECK_FAST(contains(h));
+            return values_[slots_[h.index].index];
+        }
+
+        reference at(handle_type h) {
+            THROW_OUT_OF_RANGE_IF(!contains(h), "slot_map<T>::at() stale handle");
+            return (*this)[h];
+        }
+
+        const_reference at(handle_type h) const {
+            THROW_OUT_OF_RANGE_IF(!contains(h), "slot_map<T>::at() stale handle");
+            return (*this)[h];
+        }
+
+        // 由紧密存放的迭代器取得对应的句柄
+        handle_type handle_of(const_iterator pos) const {
+            const uint32_t s = value_slot_[pos - values_.begin()];
+            return handle_type{ s, slots_[s].generation };
+        }
+
+    public:
+        // 修改容器操作
+        handle_type insert(const value_type& value) { return emplace(value); }
+        handle_type insert(value_type&& value) { return emplace(laistl::move(value)); }
+
+        template <class... Args>
+        handle_type emplace(Args&& ...args);
+
+        bool erase(handle_type h);
+        void clear();
+
+    private:
+        uint32_t acquire_slot();
+    };
+
+    // 在尾部构造元素并分配一个槽位
+    // 后续步骤抛出异常时撤销已完成的步骤，三个数组保持一致；acquire_slot 放在最后，失败时不改变空闲链表
+    template <class T>
+    template <class ...Args>
+    typename slot_map<T>::handle_type
+    slot_map<T>::emplace(Args&& ...args) {
+        values_.emplace_back(laistl::forward<Args>(args)...);
+        uint32_t s = npos;
+        MYSTL_TRY {
+            value_slot_.push_back(s);
+            s = acquire_slot();
+        }
+        MYSTL_CATCH_ALL {
+            if (value_slot_.size() == values_.size()) {
+                value_slot_.pop_back();
+            }
+            values_.pop_back();
+            MYSTL_RETHROW;
+        }
+        value_slot_.back() = s;
+        slots_[s].index = static_cast<uint32_t>(values_.size() - 1);
+        return handle_type{ s, slots_[s].generation };
+    }
+
+    // 删除句柄对应的元素：最后一个元素移入空位，槽位代数加一后放回空闲链表
+    template <class T>
+    bool slot_map<T>::erase(handle_type h) {
+        if (!contains(h)) {
+            return false;
+        }
+        const uint32_t pos = slots_[h.index].index;
+        const uint32_t last = static_cast<uint32_t>(values_.size() - 1);
+        if (pos != last) {
+            values_[pos] = laistl::move(values_[last]);
+            value_slot_[pos] = value_slot_[last];
+            slots_[value_slot_[pos]].index = pos;
+        }
+        values_.pop_back();
+        value_slot_.pop_back();
+        ++slots_[h.index].generation;
+        slots_[h.index].index = free_head_;
+        free_head_ = h.index;
+        return true;
+    }
+
+    // 删除全部元素，所有已发出的句柄都会失效
+    template <class T>
+    void slot_map<T>::clear() {
+        for (size_type i = 0; i < value_slot_.size(); ++i) {
+            const uint32_t s = value_slot_[i];
+            ++slots_[s].generation;
+            slots_[s].index = free_head_;
+            free_head_ = s;
+        }
+        values_.clear();
+        value_slot_.clear();
+    }
+
+    // 优先复用空闲链表中的槽位
+    template <class T>
+    uint32_t slot_map<T>::acquire_slot() {
+        if (free_head_ != npos) {
+            const uint32_t s = free_head_;
+            free_head_ = slots_[s].index;
+            return s;
+        }
+        slots_.push_back(slot{ 0, 0 });
+        return static_cast<uint32_t>(slots_.size() - 1);
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
+} /* namespace laistl */
+
+#endif /* _SLOT_MAP_H */
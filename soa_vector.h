@@ -0,0 +1,527 @@
+#ifndef _SOA_VECTOR_H
+#define _SOA_VECTOR_H
+
+// 结构数组（structure of arrays）容器
+// 每个字段存放在各自连续的列中，所有列共用一次分配并一起增长，只扫描某一列时不会拖入其他字段
+
+#include <cstdint>
+#include <tuple>
+#include <initializer_list>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
+    // soa_column: 某一列的视图，begin/end 为原生指针，可直接交给 algobase 中的批量算法
+    template <class T>
+    struct soa_column {
+        T*      first;
+        size_t  count;
+
+        T*      data()  const noexcept { return first; }
+        size_t  size()  const noexcept { return count; }
+        T*      begin() const noexcept { return first; }
+        T*      end()   const noexcept { return first + count; }
+        T&      operator[](size_t n) const { return first[n]; }
+    };
+
+    // soa_reference: 一行元素的代理引用，行为与 std::tuple<Ts&...> 相同
+    // 两列时还可以与 laistl::pair 互相赋值、转换
+    template <class... Ts>
+    struct soa_reference : public std::tuple<Ts&...> {
+        using base = std::tuple<Ts&...>;
+
+        explicit soa_reference(Ts&... refs) : base(refs...) {}
+        soa_reference(const soa_reference&) = default;
+
+        template <size_t I>
+        typename std::tuple_element<I, base>::type get() const { return std::get<I>(*this); }
+
+        soa_reference& operator=(const soa_reference& rhs) {
+            base::operator=(static_cast<const base&>(rhs));
+            return *this;
+        }
+
+        soa_reference& operator=(const std::tuple<Ts...>& rhs) {
+            base::operator=(rhs);
+            return *this;
+        }
+
+        template <class K, class V, size_t N = sizeof...(Ts), typename std::enable_if<N == 2, int>::type = 0>
+        soa_reference& operator=(const laistl::pair<K, V>& rhs) {
+            std::get<0>(*this) = rhs.first;
+            std::get<1>(*this) = rhs.second;
+            return *this;
+        }
+
+        template <class K, class V, size_t N = sizeof...(Ts), typename std::enable_if<N == 2, int>::type = 0>
+        operator laistl::pair<K, V>() const {
+            return laistl::pair<K, V>(std::get<0>(*this), std::get<1>(*this));
+        }
+
+        operator std::tuple<Ts...>() const { return std::tuple<Ts...>(static_cast<const base&>(*this)); }
+    };
+
+    template <size_t I, class... Ts>
+    typename std::tuple_element<I, std::tuple<Ts&...>>::type
+    get(const soa_reference<Ts...>& ref) {
+        return std::get<I>(ref);
+    }
+
+    // 模板类：soa_vector
+    // 每列的起始地址按 column_align 对齐，列 i 位于 cols_[i]
+    template <class... Ts>
+    class soa_vector {
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+    public:
+        typedef size_t                          size_type;
+        typedef ptrdiff_t                       difference_type;
+        typedef std::tuple<Ts...>               value_type;
+        typedef soa_reference<Ts...>            reference;
+        typedef soa_reference<const Ts...>      const_reference;
+
+        template <size_t I>
+        using column_type = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+
+        template <class Ref, class Vec>
+        class row_iterator;
+
+        typedef row_iterator<reference, soa_vector>                iterator;
+        typedef row_iterator<const_reference, const soa_vector>    const_iterator;
+
+    private:
+        static constexpr size_t column_count = sizeof...(Ts);
+        static constexpr size_t column_align = cache_line_size;
+        using byte_allocator = laistl::allocator<unsigned char>;
+        using indices = laistl::make_index_sequence<sizeof...(Ts)>;
+
+        // 逐列递归时的列号标记，column_end 表示所有列都已处理
+        template <size_t I>
+        using column_tag = m_integral_constant<size_t, I>;
+        using column_end = column_tag<sizeof...(Ts)>;
+
+        unsigned char*  buf_;                   // 所有列共用的存储
+        void*           cols_[column_count];    // 各列的起始地址
+        size_type       size_;
+        size_type       cap_;
+
+    public:
+        // 构造、复制、移动、析构函数
+        soa_vector() noexcept : buf_(nullptr), size_(0), cap_(0) { reset_columns(); }
+
+        explicit soa_vector(size_type n) : buf_(nullptr), size_(0), cap_(0) {
+            reset_columns();
+            MYSTL_TRY {
+                resize(n);
+            }
+            MYSTL_CATCH_ALL {
+                byte_allocator::deallocate_aligned(buf_);
+                MYSTL_RETHROW;
+            }
+        }
+
+        soa_vector(const soa_vector& rhs) : buf_(nullptr), size_(0), cap_(0) {
+            reset_columns();
+            reserve(rhs.size_);
+            MYSTL_TRY {
+                copy_columns(rhs, column_tag<0>());
+            }
+            MYSTL_CATCH_ALL {
+                byte_allocator::deallocate_aligned(buf_);
+                MYSTL_RETHROW;
+            }
+            size_ = rhs.size_;
+        }
+
+        soa_vector(soa_vector&& rhs) noexcept : buf_(nullptr), size_(0), cap_(0) {
+            reset_columns();
+            swap(rhs);
+        }
+
+        soa_vector& operator=(const soa_vector& rhs) {
+            if (this != &rhs) {
+                soa_vector tmp(rhs);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        soa_vector& operator=(soa_vector&& rhs) noexcept {
+            soa_vector tmp(laistl::move(rhs));
+            swap(tmp);
+            return *this;
+        }
+
+        ~soa_vector() {
+            clear();
+            byte_allocator::deallocate_aligned(buf_);
+        }
+
+    public:
+        // 迭代器操作
+        iterator        begin()         noexcept { return iterator(this, 0); }
+        const_iterator  begin()   const noexcept { return const_iterator(this, 0); }
+        iterator        end()           noexcept { return iterator(this, size_); }
+        const_iterator  end()     const noexcept { return const_iterator(this, size_); }
+
+    public:
+        // 容器操作
+        bool empty()            const noexcept { return size_ == 0; }
+        size_type size()        const noexcept { return size_; }
+        size_type capacity()    const noexcept { return cap_; }
+        size_type max_size()    const noexcept;
+        void reserve(size_type n);
+        void shrink_to_fit() {
+            if (size_ < cap_) {
+                reallocate(size_);
+            }
+        }
+
+    public:
+        // 访问元素操作
+        reference operator[](size_type n) {
+            MYSTL_CHECK_FAST(n < size_);
+            return row<reference>(n, indices());
+        }
+
+        const_reference operator[](size_type n) const {
+            MYSTL_CHECK_FAST(n < size_);
+            return row<const_reference>(n, indices());
+        }
+
+        reference at(size_type n) {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "soa_vector<Ts...>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "soa_vector<Ts...>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference front() { MYSTL_CHECK_FAST(!empty()); return (*this)[0]; }
+        reference back()  { MYSTL_CHECK_FAST(!empty()); return (*this)[size_ - 1]; }
+
+        // 取第 I 列的连续视图
+        template <size_t I>
+        soa_column<column_type<I>> column() noexcept {
+            return soa_column<column_type<I>>{ column_data<I>(), size_ };
+        }
+
+        template <size_t I>
+        soa_column<const column_type<I>> column() const noexcept {
+            return soa_column<const column_type<I>>{ column_data<I>(), size_ };
+        }
+
+    public:
+        // 修改容器操作
+        // emplace_back: 每个参数构造对应的一列
+        template <class... Us>
+        void emplace_back(Us&& ...values);
+
+        void push_back(const Ts&... values) { emplace_back(values...); }
+
+        void push_back(const value_type& value) { push_back_tuple(value, indices()); }
+
+        template <class K, class V, size_t N = sizeof...(Ts), typename std::enable_if<N == 2, int>::type = 0>
+        void push_back(const laistl::pair<K, V>& value) { emplace_back(value.first, value.second); }
+
+        void pop_back() {
+            MYSTL_CHECK_FAST(!empty());
+            --size_;
+            destroy_rows(cols_, size_, size_ + 1, indices());
+        }
+
+        void resize(size_type n);
+        void clear() noexcept {
+            destroy_rows(cols_, 0, size_, indices());
+            size_ = 0;
+        }
+
+        void swap(soa_vector& rhs) noexcept {
+            laistl::swap(buf_, rhs.buf_);
+            laistl::swap(cols_, rhs.cols_);
+            laistl::swap(size_, rhs.size_);
+            laistl::swap(cap_, rhs.cap_);
+        }
+
+    private:
+        // helper functions
+        template <size_t I>
+        column_type<I>* column_data() const noexcept {
+            return static_cast<column_type<I>*>(cols_[I]);
+        }
+
+        void reset_columns() noexcept {
+            for (size_t i = 0; i < column_count; ++i) cols_[i] = nullptr;
+        }
+
+        template <class Ref, size_t... Is>
+        Ref row(size_type n, index_sequence<Is...>) const {
+            return Ref(column_data<Is>()[n]...);
+        }
+
+        template <size_t... Is>
+        void push_back_tuple(const value_type& value, index_sequence<Is...>) {
+            emplace_back(std::get<Is>(value)...);
+        }
+
+        // 以下逐列构造的函数在某一列抛出异常时析构本次已构造的列，再重新抛出
+        // construct_row: 在 cols 的第 I 列及之后各列的第 n 行构造元素
+        template <size_t I, class U, class... Us>
+        static void construct_row(void** cols, size_type n, column_tag<I>, U&& value, Us&& ...values) {
+            column_type<I>* p = static_cast<column_type<I>*>(cols[I]) + n;
+            laistl::construct(p, laistl::forward<U>(value));
+            MYSTL_TRY {
+                construct_row(cols, n, column_tag<I + 1>(), laistl::forward<Us>(values)...);
+            }
+            MYSTL_CATCH_ALL {
+                laistl::destroy(p);
+                MYSTL_RETHROW;
+            }
+        }
+        static void construct_row(void**, size_type, column_end) noexcept {}
+
+        template <size_t I>
+        void default_rows(size_type first, size_type last, column_tag<I>) {
+            column_type<I>* p = column_data<I>();
+            laistl::uninitialized_fill_n(p + first, last - first, column_type<I>());
+            MYSTL_TRY {
+                default_rows(first, last, column_tag<I + 1>());
+            }
+            MYSTL_CATCH_ALL {
+                laistl::destroy(p + first, p + last);
+                MYSTL_RETHROW;
+            }
+        }
+        void default_rows(size_type, size_type, column_end) noexcept {}
+
+        template <size_t... Is>
+        static void destroy_rows(void** cols, size_type first, size_type last, index_sequence<Is...>) noexcept {
+            int expand[] = { 0, (laistl::destroy(static_cast<column_type<Is>*>(cols[Is]) + first,
+                                                 static_cast<column_type<Is>*>(cols[Is]) + last), 0)... };
+            (void)expand;
+        }
+
+        template <size_t I>
+        void copy_columns(const soa_vector& rhs, column_tag<I>) {
+            column_type<I>* p = column_data<I>();
+            laistl::uninitialized_copy(rhs.column_data<I>(), rhs.column_data<I>() + rhs.size_, p);
+            MYSTL_TRY {
+                copy_columns(rhs, column_tag<I + 1>());
+            }
+            MYSTL_CATCH_ALL {
+                laistl::destroy(p, p + rhs.size_);
+                MYSTL_RETHROW;
+            }
+        }
+        void copy_columns(const soa_vector&, column_end) noexcept {}
+
+        template <size_t I>
+        void move_columns(void** new_cols, column_tag<I>) {
+            column_type<I>* p = static_cast<column_type<I>*>(new_cols[I]);
+            laistl::uninitialized_move(column_data<I>(), column_data<I>() + size_, p);
+            MYSTL_TRY {
+                move_columns(new_cols, column_tag<I + 1>());
+            }
+            MYSTL_CATCH_ALL {
+                laistl::destroy(p, p + size_);
+                MYSTL_RETHROW;
+            }
+        }
+        void move_columns(void**, column_end) noexcept {}
+
+        static size_type layout(size_type cap, void** cols, unsigned char* base);
+        size_type next_cap() const;
+        unsigned char* allocate_columns(size_type cap, void** cols);
+        void replace_storage(unsigned char* new_buf, void** new_cols, size_type new_cap) noexcept;
+        void reallocate(size_type new_cap);
+
+        template <class... Us>
+        void reallocate_emplace(Us&& ...values);
+    };
+
+    // 行迭代器，解引用得到代理引用
+    template <class... Ts>
+    template <class Ref, class Vec>
+    class soa_vector<Ts...>::row_iterator
+        : public laistl::iterator<laistl::random_access_iterator_tag, std::tuple<Ts...>, ptrdiff_t, void, Ref> {
+    private:
+        Vec*        vec_;
+        size_type   idx_;
+    public:
+        using self = row_iterator<Ref, Vec>;
+
+        row_iterator() : vec_(nullptr), idx_(0) {}
+        row_iterator(Vec* v, size_type i) : vec_(v), idx_(i) {}
+
+        Ref operator*() const { return (*vec_)[idx_]; }
+        Ref operator[](difference_type n) const { return (*vec_)[idx_ + n]; }
+
+        self& operator++() { ++idx_; return *this; }
+        self operator++(int) { self tmp = *this; ++idx_; return tmp; }
+        self& operator--() { --idx_; return *this; }
+        self operator--(int) { self tmp = *this; --idx_; return tmp; }
+
+        self& operator+=(difference_type n) { idx_ += n; return *this; }
+        self& operator-=(difference_type n) { idx_ -= n; return *this; }
+        self operator+(difference_type n) const { return self(vec_, idx_ + n); }
+        self operator-(difference_type n) const { return self(vec_, idx_ - n); }
+        difference_type operator-(const self& rhs) const {
+            return static_cast<difference_type>(idx_) - static_cast<difference_type>(rhs.idx_);
+        }
+
+        bool operator==(const self& rhs) const { return idx_ == rhs.idx_; }
+        bool operator!=(const self& rhs) const { return idx_ != rhs.idx_; }
+        bool operator<(const self& rhs) const { return idx_ < rhs.idx_; }
+    };
+
+    // 一行的字节数乘以行数，再加上各列对齐的填充，总字节数不超过 PTRDIFF_MAX
+    template <class... Ts>
+    typename soa_vector<Ts...>::size_type
+    soa_vector<Ts...>::max_size() const noexcept {
+        const size_t sizes[] = { sizeof(Ts)... };
+        size_type row_bytes = 0;
+        for (size_t i = 0; i < column_count; ++i) {
+            row_bytes += sizes[i];
+        }
+        return (static_cast<size_type>(PTRDIFF_MAX) - column_count * column_align) / row_bytes;
+    }
+
+    // 预留空间，所有列一起扩容
+    template <class... Ts>
+    void soa_vector<Ts...>::reserve(size_type n) {
+        if (n > cap_) {
+            THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in soa_vector<Ts...>::reserve(n)");
+            reallocate(n);
+        }
+    }
+
+    template <class... Ts>
+    template <class... Us>
+    void soa_vector<Ts...>::emplace_back(Us&& ...values) {
+        static_assert(sizeof...(Us) == sizeof...(Ts), "soa_vector::emplace_back needs one value per column");
+        if (size_ == cap_) {
+            reallocate_emplace(laistl::forward<Us>(values)...);
+        } else {
+            construct_row(cols_, size_, column_tag<0>(), laistl::forward<Us>(values)...);
+        }
+        ++size_;
+    }
+
+    template <class... Ts>
+    void soa_vector<Ts...>::resize(size_type n) {
+        if (n < size_) {
+            destroy_rows(cols_, n, size_, indices());
+        } else if (n > size_) {
+            reserve(n);
+            default_rows(size_, n, column_tag<0>());
+        }
+        size_ = n;
+    }
+
+    // layout: 计算容量为 cap 时各列的偏移，base 非空时写入各列地址，返回总字节数
+    template <class... Ts>
+    typename soa_vector<Ts...>::size_type
+    soa_vector<Ts...>::layout(size_type cap, void** cols, unsigned char* base) {
+        const size_t sizes[] = { sizeof(Ts)... };
+        size_type offset = 0;
+        for (size_t i = 0; i < column_count; ++i) {
+            offset = (offset + column_align - 1) & ~(column_align - 1);
+            if (base != nullptr) {
+                cols[i] = base + offset;
+            }
+            offset += cap * sizes[i];
+        }
+        return offset;
+    }
+
+    // next_cap: 尾部插入时的新容量，按 1.5 倍增长，不超过 max_size()
+    template <class... Ts>
+    typename soa_vector<Ts...>::size_type
+    soa_vector<Ts...>::next_cap() const {
+        const size_type max = max_size();
+        THROW_LENGTH_ERROR_IF(cap_ >= max, "soa_vector<Ts...>'s size too big");
+        if (cap_ == 0) {
+            return laistl::min<size_type>(16, max);
+        }
+        return cap_ > max - cap_ / 2 ? max : cap_ + cap_ / 2;
+    }
+
+    // allocate_columns: 分配容量为 cap 的存储并写入各列地址，cap 为 0 时不分配
+    template <class... Ts>
+    unsigned char* soa_vector<Ts...>::allocate_columns(size_type cap, void** cols) {
+        if (cap == 0) {
+            for (size_t i = 0; i < column_count; ++i) cols[i] = nullptr;
+            return nullptr;
+        }
+        unsigned char* buf = byte_allocator::allocate_aligned(layout(cap, nullptr, nullptr), column_align);
+        layout(cap, cols, buf);
+        return buf;
+    }
+
+    // replace_storage: 析构旧存储中的元素并释放，改用新存储
+    template <class... Ts>
+    void soa_vector<Ts...>::replace_storage(unsigned char* new_buf, void** new_cols, size_type new_cap) noexcept {
+        destroy_rows(cols_, 0, size_, indices());
+        byte_allocator::deallocate_aligned(buf_);
+        buf_ = new_buf;
+        for (size_t i = 0; i < column_count; ++i) cols_[i] = new_cols[i];
+        cap_ = new_cap;
+    }
+
+    // reallocate: 一次分配新存储，逐列把元素移动过去
+    template <class... Ts>
+    void soa_vector<Ts...>::reallocate(size_type new_cap) {
+        void* new_cols[column_count];
+        unsigned char* new_buf = allocate_columns(new_cap, new_cols);
+        MYSTL_TRY {
+            move_columns(new_cols, column_tag<0>());
+        }
+        MYSTL_CATCH_ALL {
+            byte_allocator::deallocate_aligned(new_buf);
+            MYSTL_RETHROW;
+        }
+        replace_storage(new_buf, new_cols, new_cap);
+    }
+
+    // reallocate_emplace: 先在新存储中构造新行，再搬移旧元素，参数引用旧存储中的元素时仍然有效
+    template <class... Ts>
+    template <class... Us>
+    void soa_vector<Ts...>::reallocate_emplace(Us&& ...values) {
+        const size_type new_cap = next_cap();
+        void* new_cols[column_count];
+        unsigned char* new_buf = allocate_columns(new_cap, new_cols);
+        MYSTL_TRY {
+            construct_row(new_cols, size_, column_tag<0>(), laistl::forward<Us>(values)...);
+            MYSTL_TRY {
+                move_columns(new_cols, column_tag<0>());
+            }
+            MYSTL_CATCH_ALL {
+                destroy_rows(new_cols, size_, size_ + 1, indices());
+                MYSTL_RETHROW;
+            }
+        }
+        MYSTL_CATCH_ALL {
+            byte_allocator::deallocate_aligned(new_buf);
+            MYSTL_RETHROW;
+        }
+        replace_storage(new_buf, new_cols, new_cap);
+    }
+
+    // 重载 swap
+    template <class... Ts>
+    void swap(soa_vector<Ts...>& lhs, soa_vector<Ts...>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
+} /* namespace laistl */
+
+#endif /* _SOA_VECTOR_H */
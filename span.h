@@ -0,0 +1,141 @@
+#ifndef _SPAN_H
+#define _SPAN_H
+
+// 非拥有的连续区间视图 span
+// 只保存指针和长度，可由 vector、数组或任意提供 data() / size() 的连续容器直接构造，不复制元素
+
+#include <type_traits>
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "simd_search.h"
+#include "util.h"
+
+namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
+    // 模板类：span
+    template <class T>
+    class span {
+    public:
+        typedef T                                           element_type;
+        typedef typename std::remove_cv<T>::type            value_type;
+        typedef T*                                          pointer;
+        typedef T&                                          reference;
+        typedef size_t                                      size_type;
+        typedef ptrdiff_t                                   difference_type;
+
+        typedef T*                                          iterator;
+        typedef laistl::reverse_iterator<iterator>          reverse_iterator;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        T*          data_;
+        size_type   size_;
+
+    public:
+        // 构造函数
+        span() noexcept : data_(nullptr), size_(0) {}
+        span(T* p, size_type n) noexcept : data_(p), size_(n) {}
+        span(T* first, T* last) noexcept : data_(first), size_(static_cast<size_type>(last - first)) {}
+
+        template <size_t N>
+        span(T (&arr)[N]) noexcept : data_(arr), size_(N) {}
+
+        // 从提供 data() / size() 的连续容器构造，如 vector<T>
+        template <class Container, typename std::enable_if<
+            std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value &&
+            !std::is_same<typename std::decay<Container>::type, span>::value, int>::type = 0>
+        span(Container& c) noexcept : data_(c.data()), size_(static_cast<size_type>(c.size())) {}
+
+        // span<T> 可转换为 span<const T>
+        template <class U, typename std::enable_if<
+            std::is_convertible<U(*)[], T(*)[]>::value, int>::type = 0>
+        span(const span<U>& rhs) noexcept : data_(rhs.data()), size_(rhs.size()) {}
+
+    public:
+        // 迭代器操作
+        iterator            begin()  const noexcept { return data_; }
+        iterator            end()    const noexcept { return data_ + size_; }
+        reverse_iterator    rbegin() const noexcept { return reverse_iterator(end()); }
+        reverse_iterator    rend()   const noexcept { return reverse_iterator(begin()); }
+
+    public:
+        // 容量与访问元素操作
+        bool        empty()      const noexcept { return size_ == 0; }
+        size_type   size()       const noexcept { return size_; }
+        size_type   size_bytes() const noexcept { return size_ * sizeof(T); }
+        pointer     data()       const noexcept { return data_; }
+
+        reference operator[](size_type n) const {
+            MYSTL_CHECK_FAST(n < size_);
+            return data_[n];
+        }
+
+        reference front() const { MYSTL_CHECK_FAST(!empty()); return data_[0]; }
+        reference back()  const { MYSTL_CHECK_FAST(!empty()); return data_[size_ - 1]; }
+
+    public:
+        // 子视图
+        span first(size_type n) const {
+            MYSTL_DEBUG(n <= size_);
+            return span(data_, n);
+        }
+
+        span last(size_type n) const {
+            MYSTL_DEBUG(n <= size_);
+            return span(data_ + (size_ - n), n);
+        }
+
+        span subspan(size_type pos, size_type n = npos) const {
+            THROW_OUT_OF_RANGE_IF(pos > size_, "span<T>::subspan() pos out of range");
+            return span(data_ + pos, laistl::min(n, size_ - pos));
+        }
+
+    public:
+        // 查找，找不到时返回 npos；单字节整型元素走向量化版本
+        size_type find(const value_type& value, size_type pos = 0) const noexcept {
+            return find_dispatch(value, pos, byte_like());
+        }
+
+    private:
+        typedef m_bool_constant<std::is_integral<value_type>::value && sizeof(value_type) == 1 &&
+                                !std::is_same<value_type, bool>::value> byte_like;
+
+        size_type find_dispatch(const value_type& value, size_type pos, m_true_type) const noexcept {
+            if (pos >= size_) {
+                return npos;
+            }
+            const char* first = reinterpret_cast<const char*>(data_);
+            const char* last = first + size_;
+            const char* r = laistl::find_byte(first + pos, last, static_cast<char>(value));
+            return r == last ? npos : static_cast<size_type>(r - first);
+        }
+
+        size_type find_dispatch(const value_type& value, size_type pos, m_false_type) const noexcept {
+            for (size_type i = pos; i < size_; ++i) {
+                if (data_[i] == value) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+    };
+
+    // 由指针和长度构造 span 的辅助函数
+    template <class T>
+    span<T> make_span(T* p, size_t n) noexcept {
+        return span<T>(p, n);
+    }
+
+    template <class Container>
+    auto make_span(Container& c) noexcept
+        -> span<typename std::remove_pointer<decltype(c.data())>::type> {
+        return span<typename std::remove_pointer<decltype(c.data())>::type>(c);
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
+} /* namespace laistl */
+
+#endif /* _SPAN_H */
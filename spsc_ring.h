@@ -0,0 +1,223 @@
+#ifndef _SPSC_RING_H
+#define _SPSC_RING_H
+
+// 单生产者/单消费者无锁环形缓冲区
+// 读写下标分别位于独立的缓存行，并各自缓存对方的下标，减少跨核通信
+
+#include <atomic>
+
+#include "allocator.h"
+#include "algobase.h"
+#include "exceptdef.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace laistl {
+    // 模板类：spsc_ring
+    // 容量向上取整为 2 的幂，下标单调递增，用 (idx & mask_) 定位槽位
+    // 同一时刻只允许一个线程调用 push 系列函数，一个线程调用 pop 系列函数
+    template <class T>
+    class spsc_ring {
+    public:
+        using allocator_type = laistl::allocator<T>;
+        using data_allocator = laistl::allocator<T>;
+
+        typedef typename allocator_type::value_type         value_type;
+        typedef typename allocator_type::pointer            pointer;
+        typedef typename allocator_type::reference          reference;
+        typedef typename allocator_type::const_reference    const_reference;
+        typedef typename allocator_type::size_type          size_type;
+
+    private:
+        // 只读部分，构造后不再修改
+        alignas(cache_line_size) pointer buffer_;   // 槽位数组
+        size_type mask_;                            // 容量 - 1
+
+        // 生产者独占的缓存行
+        alignas(cache_line_size) std::atomic<size_type> tail_;  // 下一个写入位置
+        size_type head_cache_;                                  // 生产者看到的读位置
+
+        // 消费者独占的缓存行
+        alignas(cache_line_size) std::atomic<size_type> head_;  // 下一个读取位置
+        size_type tail_cache_;                                  // 消费者看到的写位置
+
+    public:
+        // 构造、析构函数
+        explicit spsc_ring(size_type n);
+        ~spsc_ring();
+
+        spsc_ring(const spsc_ring&) = delete;
+        spsc_ring& operator=(const spsc_ring&) = delete;
+
+    public:
+        // 容量相关操作，在并发读写时只是一个近似值
+        size_type capacity() const noexcept { return mask_ + 1; }
+        size_type size() const noexcept {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+        bool empty() const noexcept { return size() == 0; }
+
+    public:
+        // 生产者操作
+        bool try_push(const value_type& value) { return try_emplace(value); }
+        bool try_push(value_type&& value) { return try_emplace(laistl::move(value)); }
+
+        template <class... Args>
+        bool try_emplace(Args&& ...args);
+
+        template <class ForwardIter>
+        size_type push_n(ForwardIter first, size_type n);
+
+        // 消费者操作
+        bool try_pop(value_type& value);
+
+        template <class OutputIter>
+        size_type pop_n(OutputIter result, size_type n);
+
+    private:
+        // helper functions
+        static size_type round_up_pow2(size_type n);
+        size_type writable(size_type tail, size_type want);
+        size_type readable(size_type head, size_type want);
+    };
+
+    // 构造函数
+    template <class T>
+    spsc_ring<T>::spsc_ring(size_type n)
+        : buffer_(nullptr), mask_(0), tail_(0), head_cache_(0), head_(0), tail_cache_(0)
+    {
+        const size_type cap = round_up_pow2(n);
+        buffer_ = data_allocator::allocate(cap);
+        mask_ = cap - 1;
+    }
+
+    // 析构函数，销毁尚未被取出的元素
+    template <class T>
+    spsc_ring<T>::~spsc_ring() {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        for (size_type head = head_.load(std::memory_order_relaxed); head != tail; ++head) {
+            data_allocator::destroy(buffer_ + (head & mask_));
+        }
+        data_allocator::deallocate(buffer_, capacity());
+    }
+
+    // 在尾部就地构造元素，缓冲区已满时返回 false
+    template <class T>
+    template <class ...Args>
+    bool spsc_ring<T>::try_emplace(Args&& ...args) {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        if (writable(tail, 1) == 0) {
+            return false;
+        }
+        data_allocator::construct(buffer_ + (tail & mask_), laistl::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 批量写入 [first, first + n) 中的元素，返回实际写入的个数
+    // 写入区域至多被环的末尾分成两段，每段都走 uninitialized_copy 的批量路径
+    template <class T>
+    template <class ForwardIter>
+    typename spsc_ring<T>::size_type
+    spsc_ring<T>::push_n(ForwardIter first, size_type n) {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        n = laistl::min(n, writable(tail, n));
+        if (n == 0) {
+            return 0;
+        }
+        const size_type slot = tail & mask_;
+        const size_type len1 = laistl::min(n, capacity() - slot);
+        auto mid = first;
+        laistl::advance(mid, len1);
+        laistl::uninitialized_copy(first, mid, buffer_ + slot);
+        if (len1 < n) {
+            // 第二段构造失败时销毁第一段，tail_ 尚未发布，这些槽位对消费者不可见
+            MYSTL_TRY {
+                laistl::uninitialized_copy_n(mid, n - len1, buffer_);
+            }
+            MYSTL_CATCH_ALL {
+                data_allocator::destroy(buffer_ + slot, buffer_ + slot + len1);
+                MYSTL_RETHROW;
+            }
+        }
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // 从头部取出一个元素，缓冲区为空时返回 false
+    template <class T>
+    bool spsc_ring<T>::try_pop(value_type& value) {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        if (readable(head, 1) == 0) {
+            return false;
+        }
+        pointer p = buffer_ + (head & mask_);
+        value = laistl::move(*p);
+        data_allocator::destroy(p);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 批量取出至多 n 个元素移动到 result 处，返回实际取出的个数
+    template <class T>
+    template <class OutputIter>
+    typename spsc_ring<T>::size_type
+    spsc_ring<T>::pop_n(OutputIter result, size_type n) {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        n = laistl::min(n, readable(head, n));
+        if (n == 0) {
+            return 0;
+        }
+        const size_type slot = head & mask_;
+        const size_type len1 = laistl::min(n, capacity() - slot);
+        result = laistl::move(buffer_ + slot, buffer_ + slot + len1, result);
+        data_allocator::destroy(buffer_ + slot, buffer_ + slot + len1);
+        if (len1 < n) {
+            laistl::move(buffer_, buffer_ + (n - len1), result);
+            data_allocator::destroy(buffer_, buffer_ + (n - len1));
+        }
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // helper functions
+    // round_up_pow2: 把容量向上取整为 2 的幂，至少为 2；取整后无法分配的容量抛出 length_error
+    template <class T>
+    typename spsc_ring<T>::size_type
+    spsc_ring<T>::round_up_pow2(size_type n) {
+        const size_type max_cap = (static_cast<size_type>(-1) / 2 + 1) / sizeof(T);
+        THROW_LENGTH_ERROR_IF(n > max_cap, "spsc_ring<T>'s capacity too big");
+        size_type cap = 2;
+        while (cap < n) {
+            cap <<= 1;
+        }
+        return cap;
+    }
+
+    // writable: 生产者可写入的槽位数，仅在缓存的读位置显示空间不足 want 时才重新读取 head_
+    template <class T>
+    typename spsc_ring<T>::size_type
+    spsc_ring<T>::writable(size_type tail, size_type want) {
+        size_type free = capacity() - (tail - head_cache_);
+        if (free < want) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            free = capacity() - (tail - head_cache_);
+        }
+        return free;
+    }
+
+    // readable: 消费者可读取的元素数，仅在缓存的写位置显示不足 want 个时才重新读取 tail_
+    template <class T>
+    typename spsc_ring<T>::size_type
+    spsc_ring<T>::readable(size_type head, size_type want) {
+        size_type avail = tail_cache_ - head;
+        if (avail < want) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            avail = tail_cache_ - head;
+        }
+        return avail;
+    }
+
+} /* namespace laistl */
+
+#endif /* _SPSC_RING_H */
@@ -0,0 +1,191 @@
+#ifndef _STRING_VIEW_H
+#define _STRING_VIEW_H
+
+// 非拥有的字符串视图 string_view
+// 只保存指针和长度，切片不复制数据；查找操作使用 simd_search.h 中的向量化版本
+
+#include <cstring>
+
+#include "algobase.h"
+#include "astring.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "simd_search.h"
+#include "span.h"
+#include "util.h"
+#include "vector.h"
+
+namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
+    // 类：string_view
+    class string_view {
+    public:
+        typedef char                                        value_type;
+        typedef const char*                                 pointer;
+        typedef const char*                                 const_pointer;
+        typedef const char&                                 reference;
+        typedef const char&                                 const_reference;
+        typedef size_t                                      size_type;
+        typedef ptrdiff_t                                   difference_type;
+
+        typedef const char*                                 iterator;
+        typedef const char*                                 const_iterator;
+        typedef laistl::reverse_iterator<const_iterator>    reverse_iterator;
+        typedef laistl::reverse_iterator<const_iterator>    const_reverse_iterator;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        const char* data_;
+        size_type   size_;
+
+    public:
+        // 构造函数
+        constexpr string_view() noexcept : data_(nullptr), size_(0) {}
+        constexpr string_view(const char* s, size_type n) noexcept : data_(s), size_(n) {}
+        string_view(const char* s) noexcept : data_(s), size_(std::strlen(s)) {}
+        string_view(const laistl::string& s) noexcept : data_(s.data()), size_(s.size()) {}
+        string_view(const laistl::vector<char>& v) noexcept : data_(v.data()), size_(v.size()) {}
+        string_view(laistl::span<const char> s) noexcept : data_(s.data()), size_(s.size()) {}
+
+    public:
+        // 迭代器操作
+        const_iterator          begin()  const noexcept { return data_; }
+        const_iterator          end()    const noexcept { return data_ + size_; }
+        const_iterator          cbegin() const noexcept { return begin(); }
+        const_iterator          cend()   const noexcept { return end(); }
+        const_reverse_iterator  rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator  rend()   const noexcept { return const_reverse_iterator(begin()); }
+
+    public:
+        // 容量与访问元素操作
+        bool        empty()  const noexcept { return size_ == 0; }
+        size_type   size()   const noexcept { return size_; }
+        size_type   length() const noexcept { return size_; }
+        const char* data()   const noexcept { return data_; }
+
+        const_reference operator[](size_type n) const {
+            MYSTL_CHECK_FAST(n < size_);
+            return data_[n];
+        }
+
+        const_reference at(size_type n) const {
+            THROW_OUT_OF_RANGE_IF(n >= size_, "string_view::at() subscript out of range");
+            return data_[n];
+        }
+
+        const_reference front() const { MYSTL_CHECK_FAST(!empty()); return data_[0]; }
+        const_reference back()  const { MYSTL_CHECK_FAST(!empty()); return data_[size_ - 1]; }
+
+    public:
+        // 修改视图
+        void remove_prefix(size_type n) {
+            MYSTL_DEBUG(n <= size_);
+            data_ += n;
+            size_ -= n;
+        }
+
+        void remove_suffix(size_type n) {
+            MYSTL_DEBUG(n <= size_);
+            size_ -= n;
+        }
+
+        void swap(string_view& rhs) noexcept {
+            laistl::swap(data_, rhs.data_);
+            laistl::swap(size_, rhs.size_);
+        }
+
+        string_view substr(size_type pos = 0, size_type n = npos) const {
+            THROW_OUT_OF_RANGE_IF(pos > size_, "string_view::substr() pos out of range");
+            return string_view(data_ + pos, laistl::min(n, size_ - pos));
+        }
+
+        laistl::string to_string() const { return laistl::string(data_, size_); }
+
+    public:
+        // 比较操作
+        int compare(string_view rhs) const noexcept {
+            const size_type len = laistl::min(size_, rhs.size_);
+            const int r = len == 0 ? 0 : std::memcmp(data_, rhs.data_, len);
+            if (r != 0) {
+                return r;
+            }
+            return size_ < rhs.size_ ? -1 : (size_ > rhs.size_ ? 1 : 0);
+        }
+
+        bool starts_with(string_view s) const noexcept {
+            return size_ >= s.size_ && (s.size_ == 0 || std::memcmp(data_, s.data_, s.size_) == 0);
+        }
+
+        bool ends_with(string_view s) const noexcept {
+            return size_ >= s.size_ &&
+                   (s.size_ == 0 || std::memcmp(data_ + size_ - s.size_, s.data_, s.size_) == 0);
+        }
+
+    public:
+        // 查找操作，找不到时返回 npos
+        size_type find(char ch, size_type pos = 0) const noexcept {
+            if (pos >= size_) {
+                return npos;
+            }
+            return to_index(laistl::find_byte(data_ + pos, end(), ch));
+        }
+
+        size_type find(string_view s, size_type pos = 0) const noexcept {
+            if (pos > size_) {
+                return npos;
+            }
+            if (s.size_ == 0) {
+                return pos;
+            }
+            return to_index(laistl::search_bytes(data_ + pos, end(), s.data_, s.size_));
+        }
+
+        size_type find_first_of(string_view set, size_type pos = 0) const noexcept {
+            if (pos >= size_) {
+                return npos;
+            }
+            return to_index(laistl::find_first_of_bytes(data_ + pos, end(), set.data_, set.size_));
+        }
+
+        size_type rfind(char ch, size_type pos = npos) const noexcept {
+            if (size_ == 0) {
+                return npos;
+            }
+            for (size_type i = laistl::min(pos, size_ - 1) + 1; i > 0; --i) {
+                if (data_[i - 1] == ch) {
+                    return i - 1;
+                }
+            }
+            return npos;
+        }
+
+        bool contains(string_view s) const noexcept { return find(s) != npos; }
+        bool contains(char ch) const noexcept { return find(ch) != npos; }
+
+    private:
+        size_type to_index(const char* p) const noexcept {
+            return p == end() ? npos : static_cast<size_type>(p - data_);
+        }
+    };
+
+    // 重载比较操作符
+    inline bool operator==(string_view lhs, string_view rhs) noexcept {
+        return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+    }
+
+    inline bool operator!=(string_view lhs, string_view rhs) noexcept { return !(lhs == rhs); }
+    inline bool operator<(string_view lhs, string_view rhs) noexcept { return lhs.compare(rhs) < 0; }
+    inline bool operator>(string_view lhs, string_view rhs) noexcept { return rhs < lhs; }
+    inline bool operator<=(string_view lhs, string_view rhs) noexcept { return !(rhs < lhs); }
+    inline bool operator>=(string_view lhs, string_view rhs) noexcept { return !(lhs < rhs); }
+
+    // 重载 swap
+    inline void swap(string_view& lhs, string_view& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
+} /* namespace laistl */
+
+#endif /* _STRING_VIEW_H */
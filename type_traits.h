@@ -3,9 +3,32 @@
 
 // 提取类型信息
 
+#include <cstddef>
 #include <type_traits>
 
+// C++20 起 vector、allocator、construct/destroy 和 algobase 的基本算法可以在常量求值中使用，
+// 用于在编译期生成查找表；C++11/14/17 下 MYSTL_CONSTEXPR20 为空
+// 性能测量点使用静态局部变量，定义 MYSTL_PERF_HOOKS 时不提供 constexpr
+#if __cplusplus >= 202002L && defined(__cpp_constexpr_dynamic_alloc) && \
+    defined(__cpp_lib_is_constant_evaluated) && !defined(MYSTL_PERF_HOOKS)
+    #define MYSTL_HAS_CONSTEXPR20 1
+    #define MYSTL_CONSTEXPR20 constexpr
+#else
+    #define MYSTL_HAS_CONSTEXPR20 0
+    #define MYSTL_CONSTEXPR20
+#endif
+
 namespace laistl {
+    // is_constant_evaluated: 是否处于常量求值中，memmove/memset 等快速路径据此退回逐个元素的循环
+    // C++20 之前的标准下恒为 false
+    constexpr bool is_constant_evaluated() noexcept {
+    #if defined(__cpp_lib_is_constant_evaluated)
+        return std::is_constant_evaluated();
+    #else
+        return false;
+    #endif
+    }
+
     template <class T, T v>
     struct m_integral_constant {
         static constexpr T value = v;  
@@ -17,6 +40,21 @@ namespace laistl {
     using m_true_type = m_bool_constant<true>;
     using m_false_type = m_bool_constant<false>;
 
+    // index_sequence: 编译期下标序列，用于展开参数包
+    template <size_t... Is>
+    struct index_sequence {};
+
+    template <size_t N, size_t... Is>
+    struct make_index_sequence_impl : make_index_sequence_impl<N - 1, N - 1, Is...> {};
+
+    template <size_t... Is>
+    struct make_index_sequence_impl<0, Is...> {
+        using type = index_sequence<Is...>;
+    };
+
+    template <size_t N>
+    using make_index_sequence = typename make_index_sequence_impl<N>::type;
+
     // is_pair
     template <class K, class V>
     struct pair;
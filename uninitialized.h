@@ -5,38 +5,45 @@
 
 #include "algobase.h"
 #include "construct.h"
+#include "exceptdef.h"
 #include "iterator.h"
 #include "type_traits.h"
 #include "util.h"
 
 namespace laistl {
+    // 平凡类型的版本直接对未初始化空间赋值，常量求值中不允许，各入口在常量求值时一律逐个构造
+
     // uninitialized_copy: 把[first, last) 复制到 result 为起始处的空间，返回复制结束的位置
     template <class InputIter, class ForwardIter>
-    ForwardIter unchecked_uninit_copy(InputIter first, InputIter last,
+    MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_copy(InputIter first, InputIter last,
         ForwardIter result, std::true_type) 
     {
         return laistl::copy(first, last, result);
     }
 
     template <class InputIter, class ForwardIter>
-    ForwardIter unchecked_uninit_copy(InputIter first, InputIter last,
+    MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_copy(InputIter first, InputIter last,
         ForwardIter result, std::false_type) 
     {
         auto cur = result;
-        try {
+        MYSTL_TRY {
             for (; first != last; ++first, ++cur) {
                 laistl::construct(&*cur, *first);
             }
-        } catch (...) {
-            for (; result != cur; --cur) {
-                laistl::destroy(&*cur);
+        } MYSTL_CATCH_ALL {
+            for (; result != cur; ++result) {
+                laistl::destroy(&*result);
             }
+            MYSTL_RETHROW;
         }
         return cur;
     }
 
     template <class InputIter, class ForwardIter>
-    ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result) {
+    MYSTL_CONSTEXPR20 ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result) {
+        if (laistl::is_constant_evaluated()) {
+            return laistl::unchecked_uninit_copy(first, last, result, std::false_type{});
+        }
         return laistl::unchecked_uninit_copy(first, last, result, 
                                              std::is_trivially_copy_assignable<
                                              typename iterator_traits<ForwardIter>::value_type>{});
@@ -44,31 +51,35 @@ namespace laistl {
 
     // uninitialized_copy_n: 把[first, first + n) 复制到 result 为起始处的空间，返回复制结束的位置
     template <class InputIter, class Size, class ForwardIter>
-    ForwardIter unchecked_uninit_copy_n(InputIter first, Size n,
+    MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_copy_n(InputIter first, Size n,
         ForwardIter result, std::true_type) 
     {
         return laistl::copy_n(first, n, result).second;
     }
 
     template <class InputIter, class Size, class ForwardIter>
-    ForwardIter unchecked_uninit_copy_n(InputIter first, Size n,
+    MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_copy_n(InputIter first, Size n,
         ForwardIter result, std::false_type) 
     {
         auto cur = result;
-        try {
+        MYSTL_TRY {
             for (; n > 0; --n, ++first, ++cur) {
                 laistl::construct(&*cur, *first);
             }
-        } catch (...) {
-            for (; result != cur; --cur) {
-                laistl::destroy(&*cur);
+        } MYSTL_CATCH_ALL {
+            for (; result != cur; ++result) {
+                laistl::destroy(&*result);
             }
+            MYSTL_RETHROW;
         }
         return cur;
     }
 
     template <class InputIter, class Size, class ForwardIter>
-    ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
+    MYSTL_CONSTEXPR20 ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
+        if (laistl::is_constant_evaluated()) {
+            return laistl::unchecked_uninit_copy_n(first, n, result, std::false_type{});
+        }
         return laistl::unchecked_uninit_copy_n(first, n, result, 
                                              std::is_trivially_copy_assignable<
                                              typename iterator_traits<InputIter>::value_type>{});
@@ -76,26 +87,31 @@ namespace laistl {
 
     // uninitialized_fill: 把[first, last) 区间内填充元素值 
     template <class ForwardIter, class T>
-    void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::true_type) {
+    MYSTL_CONSTEXPR20 void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::true_type) {
         laistl::fill(first, last, value);
     }
 
     template <class ForwardIter, class T>
-    void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::false_type) {
+    MYSTL_CONSTEXPR20 void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::false_type) {
         auto cur = first;
-        try {
+        MYSTL_TRY {
             for (; cur != last; ++cur) {
                 laistl::construct(&*cur, value);
             }
-        } catch (...) {
+        } MYSTL_CATCH_ALL {
             for (; first != cur; ++first) {
                 laistl::destroy(&*first);
             }
+            MYSTL_RETHROW;
         }
     }
 
     template <class ForwardIter, class T>
-    void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
+    MYSTL_CONSTEXPR20 void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
+        if (laistl::is_constant_evaluated()) {
+            laistl::unchecked_uninit_fill(first, last, value, std::false_type{});
+            return;
+        }
         laistl::unchecked_uninit_fill(first, last, value, 
                                       std::is_trivially_copy_assignable<
                                       typename iterator_traits<ForwardIter>::value_type>{});
@@ -103,57 +119,65 @@ namespace laistl {
 
     // uninitialized_fill_n: 从first位置开始，填充n个元素值，返回填充结束的位置 
     template <class ForwardIter, class Size, class T>
-    ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::true_type) {
+    MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::true_type) {
         return laistl::fill_n(first, n, value);
     }
 
     template <class ForwardIter, class Size, class T>
-    ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::false_type) {
+    MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::false_type) {
         auto cur = first;
-        try {
+        MYSTL_TRY {
             for (; n > 0; --n, ++cur) {
                 laistl::construct(&*cur, value);
             }
-        } catch (...) {
+        } MYSTL_CATCH_ALL {
             for (; first != cur; ++first) {
                 laistl::destroy(&*first);
             }
+            MYSTL_RETHROW;
         }
         return cur;
     }
 
     template <class ForwardIter, class Size, class T>
-    ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
-        laistl::unchecked_uninit_fill_n(first, n, value, 
+    MYSTL_CONSTEXPR20 ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
+        if (laistl::is_constant_evaluated()) {
+            return laistl::unchecked_uninit_fill_n(first, n, value, std::false_type{});
+        }
+        return laistl::unchecked_uninit_fill_n(first, n, value, 
                                       std::is_trivially_copy_assignable<
                                       typename iterator_traits<ForwardIter>::value_type>{});
     }
 
     // uninitialized_move: 把[first, last) 移动到 result 为起始处的空间，返回移动结束的位置
     template <class InputIter, class ForwardIter>
-    ForwardIter unchecked_uninit_move(InputIter first, InputIter last,
+    MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_move(InputIter first, InputIter last,
         ForwardIter result, std::true_type) 
     {
         return laistl::move(first, last, result);
     }
 
     template <class InputIter, class ForwardIter>
-    ForwardIter unchecked_uninit_move(InputIter first, InputIter last,
+    MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_move(InputIter first, InputIter last,
         ForwardIter result, std::false_type) 
     {
         ForwardIter cur = result;
-        try {
+        MYSTL_TRY {
             for (; first != last; ++first, ++cur) {
                 laistl::construct(&*cur, laistl::move(*first));
             }
-        } catch (...) {
+        } MYSTL_CATCH_ALL {
             laistl::destroy(result, cur);
+            MYSTL_RETHROW;
         }
         return cur;
     }
 
     template <class InputIter, class ForwardIter>
-    ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result) {
+    MYSTL_CONSTEXPR20 ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result) {
+        if (laistl::is_constant_evaluated()) {
+            return laistl::unchecked_uninit_move(first, last, result, std::false_type{});
+        }
         return laistl::unchecked_uninit_move(first, last, result, 
                                              std::is_trivially_move_assignable<
                                              typename iterator_traits<InputIter>::value_type>{});
@@ -161,32 +185,33 @@ namespace laistl {
 
     // uninitialized_move_n: 把[first, first + n) 移动到 result 为起始处的空间，返回移动结束的位置
     template <class InputIter, class Size, class ForwardIter>
-    ForwardIter unchecked_uninit_move_n(InputIter first, Size n,
+    MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_move_n(InputIter first, Size n,
         ForwardIter result, std::true_type) 
     {
         return laistl::move(first, first + n, result);
     }
 
     template <class InputIter, class Size, class ForwardIter>
-    ForwardIter unchecked_uninit_move_n(InputIter first, Size n,
+    MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_move_n(InputIter first, Size n,
         ForwardIter result, std::false_type) 
     {
         auto cur = result;
-        try {
+        MYSTL_TRY {
             for (; n > 0; --n, ++first, ++cur) {
                 laistl::construct(&*cur, laistl::move(*first));
             }
-        } catch (...) {
-            for (; result != cur; ++result) {
-                laistl::destroy(result, cur);
-            }
-            throw;
+        } MYSTL_CATCH_ALL {
+            laistl::destroy(result, cur);
+            MYSTL_RETHROW;
         }
         return cur;
     }
 
     template <class InputIter, class Size, class ForwardIter>
-    ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
+    MYSTL_CONSTEXPR20 ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
+        if (laistl::is_constant_evaluated()) {
+            return laistl::unchecked_uninit_move_n(first, n, result, std::false_type{});
+        }
         return laistl::unchecked_uninit_move_n(first, n, result, 
                                              std::is_trivially_move_assignable<
                                              typename iterator_traits<InputIter>::value_type>{});
@@ -7,34 +7,37 @@
 #include "type_traits.h"
 
 namespace laistl {
+    // 缓存行大小，用于并发容器中避免伪共享
+    constexpr size_t cache_line_size = 64;
+
     // move 
     template <class T>
-    typename std::remove_reference<T>::type&& move(T&& arg) noexcept {
+    MYSTL_CONSTEXPR20 typename std::remove_reference<T>::type&& move(T&& arg) noexcept {
         return static_cast<typename std::remove_reference<T>::type&&>(arg);
     }
     
     // forward 
     template <class T>
-    T&& forward(typename std::remove_reference<T>::type& arg) noexcept {
+    MYSTL_CONSTEXPR20 T&& forward(typename std::remove_reference<T>::type& arg) noexcept {
         return static_cast<T&&>(arg);
     }
 
     template <class T>
-    T&& forward(typename std::remove_reference<T>::type&& arg) noexcept {
+    MYSTL_CONSTEXPR20 T&& forward(typename std::remove_reference<T>::type&& arg) noexcept {
         static_assert(!std::is_lvalue_reference<T>::value, "bad forward");
         return static_cast<T&&>(arg);
     }
 
     // swap 
     template <class Tp>
-    void swap(Tp& lhs, Tp& rhs) {
+    MYSTL_CONSTEXPR20 void swap(Tp& lhs, Tp& rhs) {
         auto tmp(laistl::move(lhs));
         lhs = laistl::move(rhs);
         rhs = laistl::move(tmp);
     }
 
     template <class ForwardIter1, class ForwardIter2>
-    ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2) {
+    MYSTL_CONSTEXPR20 ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2) {
         for (; first1 != last1; ++ first1, (void) ++first2) {
             laistl::swap(*first1, *first2);
         }
@@ -42,7 +45,7 @@ namespace laistl {
     }
 
     template <class Tp, size_t N>
-    void swap(Tp(&a)[N], Tp(&b)[N]) {
+    MYSTL_CONSTEXPR20 void swap(Tp(&a)[N], Tp(&b)[N]) {
         laistl::swap_range(a, a + N, b);
     }
 
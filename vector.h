@@ -3,12 +3,26 @@
 
 #include <initializer_list>
 
+#include "growth_policy.h"
 #include "iterator.h"
 #include "memory.h"
 #include "util.h"
 #include "exceptdef.h"
 
+#ifdef MYSTL_MEMPROF
+#include "memprof.h"
+#endif
+
+// 存活容器的登记钩子，定义 MYSTL_MEMPROF 时由 memprof.h 提供，否则为空
+#ifndef MYSTL_MEMPROF_TRACK
+#define MYSTL_MEMPROF_CTOR
+#define MYSTL_MEMPROF_TRACK()   ((void)0)
+#define MYSTL_MEMPROF_TRACK_MOVED(rhs) ((void)0)
+#define MYSTL_MEMPROF_UNTRACK() ((void)0)
+#endif
+
 namespace laistl {
+inline namespace MYSTL_HARDENING_NAMESPACE {
     #ifdef max 
     #pragma message("#undefing marco max")
     #undef max 
@@ -20,7 +34,8 @@ namespace laistl {
     #endif /* min */
 
     // 模板类：vector 
-    template <class T>
+    // 第二个模板参数为容量增长策略，见 growth_policy.h
+    template <class T, class Growth = default_growth>
     class vector {
         static_assert(!std::is_same<bool, T>::value, "vector<bool> is abandoned in laistl");
     public:
@@ -38,10 +53,12 @@ namespace laistl {
 
         typedef value_type*                                 iterator;
         typedef const value_type*                           const_iterator;
-        typedef laistl::reserve_iterator<iterator>          reverse_iterator;
-        typedef laistl::reserve_iterator<const_iterator>    const_reverse_iterator;
+        typedef laistl::reverse_iterator<iterator>          reverse_iterator;
+        typedef laistl::reverse_iterator<const_iterator>    const_reverse_iterator;
 
-        allocator_type get_allocator() { return data_allocator(); }
+        typedef Growth                                      growth_policy;
+
+        MYSTL_CONSTEXPR20 allocator_type get_allocator() { return data_allocator(); }
     
     private:
         iterator begin_;    // 头指针
@@ -50,216 +67,277 @@ namespace laistl {
 
     public:
         // 构造、复制、移动、析构函数
-        vector() noexcept { try_init(); }
-        explicit vector(size_type n) { fill_init(n, value_type()); }
-        vector(size_type n, const value_type& value) { fill_init(n, value); }
+        MYSTL_MEMPROF_CTOR MYSTL_CONSTEXPR20 vector() noexcept { try_init(); MYSTL_MEMPROF_TRACK(); }
+        MYSTL_MEMPROF_CTOR MYSTL_CONSTEXPR20 explicit vector(size_type n) { fill_init(n, value_type()); MYSTL_MEMPROF_TRACK(); }
+        MYSTL_MEMPROF_CTOR MYSTL_CONSTEXPR20 vector(size_type n, const value_type& value) { fill_init(n, value); MYSTL_MEMPROF_TRACK(); }
 
         template <class Iter, typename std::enable_if<
             laistl::is_input_iterator<Iter>::value, int>::type = 0>
-        vector(Iter first, Iter last) {
-            MYSTL_DEBUG(!(last < first));
-            range_init(first, last);
+        MYSTL_MEMPROF_CTOR MYSTL_CONSTEXPR20 vector(Iter first, Iter last) {
+            range_init(first, last, iterator_category(first));
+            MYSTL_MEMPROF_TRACK();
         }
 
-        vector(const vector& rhs) {
-            range_init(rhs.begin_, rhs.end_);
+        MYSTL_MEMPROF_CTOR MYSTL_CONSTEXPR20 vector(const vector& rhs) {
+            range_init(rhs.begin_, rhs.end_, random_access_iterator_tag());
+            MYSTL_MEMPROF_TRACK();
         }
 
-        vector(vector&& rhs) noexcept 
+        MYSTL_MEMPROF_CTOR MYSTL_CONSTEXPR20 vector(vector&& rhs) noexcept
         : begin_(rhs.begin_), end_(rhs.end_), cap_(rhs.cap_) {
             rhs.begin_ = nullptr;
             rhs.end_ = nullptr;
             rhs.cap_ = nullptr;
+            MYSTL_MEMPROF_TRACK_MOVED(rhs);
         }
 
-        vector(std::initializer_list<value_type> ilist) {
-            range_init(ilist.begin(), ilist.end());
+        MYSTL_MEMPROF_CTOR MYSTL_CONSTEXPR20 vector(std::initializer_list<value_type> ilist) {
+            range_init(ilist.begin(), ilist.end(), random_access_iterator_tag());
+            MYSTL_MEMPROF_TRACK();
         }
 
-        vector& operator=(const vector& rhs);
-        vector& operator=(vector&& rhs) noexcept;
+        MYSTL_CONSTEXPR20 vector& operator=(const vector& rhs);
+        MYSTL_CONSTEXPR20 vector& operator=(vector&& rhs) noexcept;
 
-        vector& operator=(std::initializer_list<value_type> ilist) {
+        MYSTL_CONSTEXPR20 vector& operator=(std::initializer_list<value_type> ilist) {
             vector tmp(ilist.begin(), ilist.end());
             swap(tmp);
             return *this;
         }
 
-        ~vector() {
+        MYSTL_CONSTEXPR20 ~vector() {
+            MYSTL_MEMPROF_UNTRACK();
             destroy_and_recover(begin_, end_,  cap_ - begin_);
             begin_ = end_ = cap_ = nullptr;
         }
 
     public:
         // 迭代器操作 
-        iterator                begin()         noexcept { return begin_; }
-        const_iterator          begin()   const noexcept { return begin_; }
-        iterator                end()           noexcept { return end_; }
-        const_iterator          end()     const noexcept { return end_; }
-
-        reverse_iterator        rbegin()        noexcept { return reserve_iterator(end()); }
-        const_reverse_iterator  rbegin()  const noexcept { return reserve_iterator(end()); }
-        reverse_iterator        rend()          noexcept { return reserve_iterator(begin()); }
-        const_reverse_iterator  rend()    const noexcept { return reserve_iterator(begin()); }
+        MYSTL_CONSTEXPR20 iterator                begin()         noexcept { return begin_; }
+        MYSTL_CONSTEXPR20 const_iterator          begin()   const noexcept { return begin_; }
+        MYSTL_CONSTEXPR20 iterator                end()           noexcept { return end_; }
+        MYSTL_CONSTEXPR20 const_iterator          end()     const noexcept { return end_; }
+
+        MYSTL_CONSTEXPR20 reverse_iterator        rbegin()        noexcept { return reverse_iterator(end()); }
+        MYSTL_CONSTEXPR20 const_reverse_iterator  rbegin()  const noexcept { return const_reverse_iterator(end()); }
+        MYSTL_CONSTEXPR20 reverse_iterator        rend()          noexcept { return reverse_iterator(begin()); }
+        MYSTL_CONSTEXPR20 const_reverse_iterator  rend()    const noexcept { return const_reverse_iterator(begin()); }
         
-        const_iterator          cbegin()  const noexcept { return begin(); }
-        const_iterator          cend()    const noexcept { return end(); }
-        const_reverse_iterator  crbegin() const noexcept { return rbengin(); }
-        const_reverse_iterator  crend()   const noexcept { return rend(); }
+        MYSTL_CONSTEXPR20 const_iterator          cbegin()  const noexcept { return begin(); }
+        MYSTL_CONSTEXPR20 const_iterator          cend()    const noexcept { return end(); }
+        MYSTL_CONSTEXPR20 const_reverse_iterator  crbegin() const noexcept { return rbegin(); }
+        MYSTL_CONSTEXPR20 const_reverse_iterator  crend()   const noexcept { return rend(); }
     public:
         // 容器操作 
-        bool empty()            const noexcept { return begin_ == end_; }
-        size_type size()        const noexcept { return static_cast<size_type>(end_ - begin_); }
-        size_type max_size()    const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
-        size_type capacity()    const noexcept { return static_cast<size_type>(cap_ - begin_); }
-        void reserve(size_type n);
-        void shrink_to_fit();
+        MYSTL_CONSTEXPR20 bool empty()            const noexcept { return begin_ == end_; }
+        MYSTL_CONSTEXPR20 size_type size()        const noexcept { return static_cast<size_type>(end_ - begin_); }
+        MYSTL_CONSTEXPR20 size_type max_size()    const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+        MYSTL_CONSTEXPR20 size_type capacity()    const noexcept { return static_cast<size_type>(cap_ - begin_); }
+        MYSTL_CONSTEXPR20 void reserve(size_type n);
+        MYSTL_CONSTEXPR20 void shrink_to_fit();
+
+        // 内存不足或长度过大时返回 false 而不报错，容器保持不变；元素构造、移动抛出的异常照常传播
+        bool try_reserve(size_type n);
     public:
         // 访问元素操作 
-        reference operator[](size_type n) {
-            MYSTL_DEBUG(n < size());
+        MYSTL_CONSTEXPR20 reference operator[](size_type n) {
+            MYSTL_CHECK_FAST(n < size());
             return *(begin_ + n);
         }
         
-        const_reference operator[](size_type n) const {
-            MYSTL_DEBUG(n < size());
+        MYSTL_CONSTEXPR20 const_reference operator[](size_type n) const {
+            MYSTL_CHECK_FAST(n < size());
             return *(begin_ + n);
         }
         
-        reference at(size_type n) {
+        MYSTL_CONSTEXPR20 reference at(size_type n) {
             THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<T>::at() subscript out of range");
             return (*this)[n];
         }
 
-        const_reference at(size_type n) const {
+        MYSTL_CONSTEXPR20 const_reference at(size_type n) const {
             THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<T>::at() subscript out of range");
             return (*this)[n];
         }
 
-        reference front() {
-            MYSTL_DEBUG(!empty());
+        MYSTL_CONSTEXPR20 reference front() {
+            MYSTL_CHECK_FAST(!empty());
             return *begin_;
         }
 
-        const_reference front() const {
-            MYSTL_DEBUG(!empty());
+        MYSTL_CONSTEXPR20 const_reference front() const {
+            MYSTL_CHECK_FAST(!empty());
             return *begin_;
         }
     
-        reference back() {
-            MYSTL_DEBUG(!empty());
+        MYSTL_CONSTEXPR20 reference back() {
+            MYSTL_CHECK_FAST(!empty());
             return *(end_ - 1);
         }
 
-        const_reference back() const {
-            MYSTL_DEBUG(!empty());
+        MYSTL_CONSTEXPR20 const_reference back() const {
+            MYSTL_CHECK_FAST(!empty());
             return *(end_ - 1);
         }
 
-        pointer         data()       noexcept { return begin_; }
-        const_pointer   data() const noexcept { return begin_; }
+        MYSTL_CONSTEXPR20 pointer         data()       noexcept { return begin_; }
+        MYSTL_CONSTEXPR20 const_pointer   data() const noexcept { return begin_; }
     public:
         // 修改容器操作 
         // assign 
-        void assign(size_type n, const value_type& value) { fill_assign(n, value); }
+        MYSTL_CONSTEXPR20 void assign(size_type n, const value_type& value) { fill_assign(n, value); }
 
         template <class Iter, typename std::enable_if<
             laistl::is_input_iterator<Iter>::value, int>::type = 0>
-        void assign(Iter first, Iter last) {
-            MYSTL_DEBUG(!(last < first));
+        MYSTL_CONSTEXPR20 void assign(Iter first, Iter last) {
             copy_assign(first, last, iterator_category(first));
         }
 
-        void assign(std::initializer_list<value_type> ilist) {
+        MYSTL_CONSTEXPR20 void assign(std::initializer_list<value_type> ilist) {
             copy_assign(ilist.begin(), ilist.end(), laistl::forward_iterator_tag{});
         }
         // emplace / emplace_back 
         template <class... Args>
-        iterator emplace(const_iterator pos, Args&& ...args);
+        MYSTL_CONSTEXPR20 iterator emplace(const_iterator pos, Args&& ...args);
 
         template <class... Args>
-        void emplace_back(Args&& ...args);
+        MYSTL_CONSTEXPR20 void emplace_back(Args&& ...args);
     
         // push_back / pop_back 
-        void push_back(const value_type& value);
-        void push_back(value_type&& value) { emplace_back(laistl::move(value)); }
-        void pop_back();
+        MYSTL_CONSTEXPR20 void push_back(const value_type& value);
+        MYSTL_CONSTEXPR20 void push_back(value_type&& value) { emplace_back(laistl::move(value)); }
+        MYSTL_CONSTEXPR20 void pop_back();
+
+        // 不检查容量的版本，调用者须保证 size() < capacity()，例如已经 reserve
+        template <class... Args>
+        MYSTL_CONSTEXPR20 void emplace_back_unchecked(Args&& ...args) {
+            MYSTL_DEBUG(end_ < cap_);
+            data_allocator::construct(laistl::address_of(*end_), laistl::forward<Args>(args)...);
+            ++end_;
+        }
+        MYSTL_CONSTEXPR20 void push_back_unchecked(const value_type& value) { emplace_back_unchecked(value); }
+        MYSTL_CONSTEXPR20 void push_back_unchecked(value_type&& value) { emplace_back_unchecked(laistl::move(value)); }
+
+        // 需要扩容而分配失败时返回 false，容器保持不变
+        template <class... Args>
+        bool try_emplace_back(Args&& ...args);
+        bool try_push_back(const value_type& value) { return try_emplace_back(value); }
+        bool try_push_back(value_type&& value) { return try_emplace_back(laistl::move(value)); }
+
+        // 批量追加：只检查一次容量，然后直接在未初始化的空间上构造
+        template <class Iter, typename std::enable_if<
+            laistl::is_input_iterator<Iter>::value, int>::type = 0>
+        MYSTL_CONSTEXPR20 void append_range(Iter first, Iter last) {
+            append_range_dispatch(first, last, iterator_category(first));
+        }
+
+        // 追加 n 个由 gen() 生成的元素
+        template <class Generator>
+        MYSTL_CONSTEXPR20 void append_n(size_type n, Generator gen);
 
         // insert 
-        iterator insert(const_iterator pos, const value_type& value);
-        iterator insert(const_iterator pos, value_type&& value) {
-            emplace(pos, laistl::move(value));
+        MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, const value_type& value);
+        MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, value_type&& value) {
+            return emplace(pos, laistl::move(value));
         }
 
-        iterator insert(const_iterator pos, size_type n, const value_type& value) {
+        MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, size_type n, const value_type& value) {
             MYSTL_DEBUG(pos >= begin() && pos <= end());
             return fill_insert(const_cast<iterator>(pos), n, value);
         }
 
         template <class Iter, typename std::enable_if<
             laistl::is_input_iterator<Iter>::value, int>::type = 0>
-        void insert(const_iterator pos, Iter first, Iter last) {
-            MYSTL_DEBUG(pos >= begin() && pos <= end() && !(last < first));
-            copy_insert(const_cast<iterator>(pos), first, last); 
+        MYSTL_CONSTEXPR20 void insert(const_iterator pos, Iter first, Iter last) {
+            MYSTL_DEBUG(pos >= begin() && pos <= end());
+            copy_insert(const_cast<iterator>(pos), first, last, iterator_category(first)); 
         }
 
         // erase / clear 
-        iterator erase(const_iterator pos);
-        iterator erase(const_iterator first, const_iterator last);
-        void clear() { erase(begin(), end()); }
+        MYSTL_CONSTEXPR20 iterator erase(const_iterator pos);
+        MYSTL_CONSTEXPR20 iterator erase(const_iterator first, const_iterator last);
+        MYSTL_CONSTEXPR20 void clear() { erase(begin(), end()); }
+
+        // 不保持顺序的删除：用尾部元素填补 pos 后弹出，O(1)
+        MYSTL_CONSTEXPR20 iterator unordered_erase(const_iterator pos);
 
         // resize / reverse 
-        void resize(size_type new_size) { return resize(new_size, value_type()); }
-        void resize(size_type new_size, const value_type& value);
+        MYSTL_CONSTEXPR20 void resize(size_type new_size) { return resize(new_size, value_type()); }
+        MYSTL_CONSTEXPR20 void resize(size_type new_size, const value_type& value);
 
-        void reverse() { laistl::reserve(begin(), end()); }
+        // 新增的元素默认初始化，对平凡类型不清零，用于随后整块写入数据的场合
+        MYSTL_CONSTEXPR20 void resize_default_init(size_type new_size);
+
+        MYSTL_CONSTEXPR20 void reverse() {
+            for (auto first = begin_, last = end_; first < last; ) {
+                laistl::iter_swap(first++, --last);
+            }
+        }
 
         // swap 
-        void swap(vector& rhs) noexcept;
+        MYSTL_CONSTEXPR20 void swap(vector& rhs) noexcept;
     
     private:
         // helper functions 
         // 初始化 / 销毁
-        void try_init() noexcept;
-        void init_space(size_type size, size_type cap);
-        void fill_init(size_type n, const value_type& value);
+        MYSTL_CONSTEXPR20 void try_init() noexcept;
+        MYSTL_CONSTEXPR20 void init_space(size_type size, size_type cap);
+        MYSTL_CONSTEXPR20 void fill_init(size_type n, const value_type& value);
+
+        template <class IIter>
+        MYSTL_CONSTEXPR20 void range_init(IIter first, IIter last, input_iterator_tag);
 
-        template <class Iter>
-        void range_init(Iter first, Iter last);
+        template <class FIter>
+        MYSTL_CONSTEXPR20 void range_init(FIter first, FIter last, forward_iterator_tag);
 
-        void destroy_and_recover(iterator first, iterator last, size_type n);
+        MYSTL_CONSTEXPR20 void destroy_and_recover(iterator first, iterator last, size_type n);
 
         // get_new_cap 
-        size_type get_new_cap(size_type add_size);
+        MYSTL_CONSTEXPR20 size_type get_new_cap(size_type add_size);
 
         // assign
-        void fill_assign(size_type n, const value_type& value);
+        MYSTL_CONSTEXPR20 void fill_assign(size_type n, const value_type& value);
+
+        template <class IIter>
+        MYSTL_CONSTEXPR20 void copy_assign(IIter first, IIter last, input_iterator_tag);
+
+        template <class FIter>
+        MYSTL_CONSTEXPR20 void copy_assign(FIter first, FIter, forward_iterator_tag);
+
+        // append
+        MYSTL_CONSTEXPR20 void reserve_for_append(size_type n);
+
+        template <class IIter>
+        MYSTL_CONSTEXPR20 void ingest(IIter& first, IIter last);
 
         template <class IIter>
-        void copy_assign(IIter first, IIter last, input_iterator_tag);
+        MYSTL_CONSTEXPR20 void append_range_dispatch(IIter first, IIter last, input_iterator_tag);
 
-        template <clas FIter>
-        void copy_assign(FIter first, FIter, forward_iterator_tag);
+        template <class FIter>
+        MYSTL_CONSTEXPR20 void append_range_dispatch(FIter first, FIter last, forward_iterator_tag);
 
         // reallocate
         template <class... Args>
-        void reallocate_emplace(iterator pos, Args&& ...args);
+        MYSTL_CONSTEXPR20 void reallocate_emplace(iterator pos, Args&& ...args);
 
-        void reallocate_insert(iterator pos, const value_type& value);
+        MYSTL_CONSTEXPR20 void reallocate_insert(iterator pos, const value_type& value);
 
         // insert 
-        iterator fill_insert(iterator pos, size_type n, const value_type& value);
+        MYSTL_CONSTEXPR20 iterator fill_insert(iterator pos, size_type n, const value_type& value);
 
-        template <class Iter>
-        void copy_insert(iterator pos, IIter first, IIter last);
+        template <class IIter>
+        MYSTL_CONSTEXPR20 void copy_insert(iterator pos, IIter first, IIter last, input_iterator_tag);
+
+        template <class FIter>
+        MYSTL_CONSTEXPR20 void copy_insert(iterator pos, FIter first, FIter last, forward_iterator_tag);
 
         // shrink_to_fit 
-        void reinsert(size_type size);
+        MYSTL_CONSTEXPR20 void reinsert(size_type size);
     };
 
     // 重载拷贝赋值操作符
-    template <class T>
-    vector<T>& vector<T>::operator=(const vector& rhs) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 vector<T, Growth>& vector<T, Growth>::operator=(const vector& rhs) {
         if (this != &rhs) {
             const auto len = rhs.size();
             if (len > capacity()) {
@@ -268,19 +346,19 @@ namespace laistl {
             } else if (size() >= len) {
                 auto i = laistl::copy(rhs.begin(), rhs.end(), begin());
                 data_allocator::destroy(i, end_);
-                end_ = begin + len;
+                end_ = begin_ + len;
             } else {
                 laistl::copy(rhs.begin(), rhs.begin() + size(), begin_);
                 laistl::uninitialized_copy(rhs.begin() + size(), rhs.end(), end_);
-                cap_ = end_ = begin_ + len;
+                end_ = begin_ + len;
             }
         }
-        retunr *this;
+        return *this;
     }
 
     // 重载移动赋值操作符
-    template <class T>
-    vector<T>& vector<T>::operator=(vector&& rhs) noexcept {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 vector<T, Growth>& vector<T, Growth>::operator=(vector&& rhs) noexcept {
         destroy_and_recover(begin_, end_, cap_ - begin_);
         begin_ = rhs.begin_;
         end_ = rhs.end_;
@@ -289,37 +367,61 @@ namespace laistl {
         rhs.begin_ = nullptr;
         rhs.end_ = nullptr;
         rhs.cap_ = nullptr;
-        retunr *this;
+        return *this;
     }
 
     // 预留空间大小， 当原空间小于要求大小时，才会重新分配
-    template <class>
-    void vector<T>::reserve(size_type n) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::reserve(size_type n) {
         if (capacity() < n) {
             THROW_LENGTH_ERROR_IF(n > max_size(), 
                                   "n can not larger than max_size() in vector<T>::reserve(n)");
             const auto old_size = size();
-            auto tmp = data_allocator::allocator(n);
+            auto tmp = data_allocator::allocate(n);
             laistl::uninitialized_move(begin_, end_, tmp);
             data_allocator::deallocate(begin_, cap_ - begin_);
             begin_ = tmp;
-            end_ = temp + old_size;
+            end_ = tmp + old_size;
             cap_ = begin_ + n;
         }
     }
+    // 预留空间，分配失败时返回 false
+    template <class T, class Growth>
+    bool vector<T, Growth>::try_reserve(size_type n) {
+        if (capacity() >= n) {
+            return true;
+        }
+        auto tmp = data_allocator::try_allocate(n);
+        if (tmp == nullptr) {
+            return false;
+        }
+        const auto old_size = size();
+        MYSTL_TRY {
+            laistl::uninitialized_move(begin_, end_, tmp);
+        } MYSTL_CATCH_ALL {
+            data_allocator::deallocate(tmp, n);
+            MYSTL_RETHROW;
+        }
+        destroy_and_recover(begin_, end_, cap_ - begin_);
+        begin_ = tmp;
+        end_ = tmp + old_size;
+        cap_ = begin_ + n;
+        return true;
+    }
+
     // 放弃多余的容量
-    template <class T>
-    void vector<T>::shrink_to_fit() {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::shrink_to_fit() {
         if (end_ < cap_) {
             reinsert(size());
         }
     }
 
     // 在pos位置就地构造元素，避免额外的复制或移动开销
-    template <class T>
+    template <class T, class Growth>
     template <class ...Args>
-    typename vector<T>::iterator
-    vector<T>::emplace(const_iterator pos, Args&& ...args) {
+    MYSTL_CONSTEXPR20 typename vector<T, Growth>::iterator
+    vector<T, Growth>::emplace(const_iterator pos, Args&& ...args) {
         MYSTL_DEBUG(pos >= begin() && pos <= end());
         iterator xpos = const_cast<iterator>(pos);
         const size_type n = xpos - begin_;
@@ -332,6 +434,7 @@ namespace laistl {
             ++new_end;
             laistl::copy_backward(xpos, end_ - 1, end_);
             *xpos = value_type(laistl::forward<Args>(args)...);
+            end_ = new_end;
         } else {
             reallocate_emplace(xpos, laistl::forward<Args>(args)...);
         }
@@ -339,20 +442,20 @@ namespace laistl {
     }
 
     // 在尾部就地构造元素，避免额外的复制或移动开销
-    template <class T>
+    template <class T, class Growth>
     template <class ...Args>
-    vector<T>::emplace_back(Args&& ...args) {
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::emplace_back(Args&& ...args) {
         if (end_ < cap_) {
             data_allocator::construct(laistl::address_of(*end_), laistl::forward<Args>(args)...);
             ++end_;
         } else {
-            reallocate_emplace(xpos, laistl::forward<Args>(args)...);
+            reallocate_emplace(end_, laistl::forward<Args>(args)...);
         }
     }
 
     // 在尾部插入元素 
-    template <class T>
-    void vector<T>::push_back(const value_type& value) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::push_back(const value_type& value) {
         if (end_ != cap_) {
             // address_of(*end_) 把end_的地址值取出来， 返回&end_ 
             // construct(&end_, value) --> new ((void*)end_) int(value);
@@ -363,18 +466,67 @@ namespace laistl {
         }
     }
 
+    // 在尾部就地构造元素，需要扩容而分配失败时返回 false
+    // 新元素先构造在新空间中，参数引用容器内的元素时也是安全的
+    template <class T, class Growth>
+    template <class ...Args>
+    bool vector<T, Growth>::try_emplace_back(Args&& ...args) {
+        if (end_ < cap_) {
+            data_allocator::construct(laistl::address_of(*end_), laistl::forward<Args>(args)...);
+            ++end_;
+            return true;
+        }
+        if (size() == max_size()) {
+            return false;
+        }
+        const size_type new_cap = Growth::grow(capacity(), size() + 1, max_size(), sizeof(T));
+        auto new_begin = data_allocator::try_allocate(new_cap);
+        if (new_begin == nullptr) {
+            return false;
+        }
+        auto pos = new_begin + size();
+        MYSTL_TRY {
+            data_allocator::construct(laistl::address_of(*pos), laistl::forward<Args>(args)...);
+        } MYSTL_CATCH_ALL {
+            data_allocator::deallocate(new_begin, new_cap);
+            MYSTL_RETHROW;
+        }
+        MYSTL_TRY {
+            laistl::uninitialized_move(begin_, end_, new_begin);
+        } MYSTL_CATCH_ALL {
+            data_allocator::destroy(pos);
+            data_allocator::deallocate(new_begin, new_cap);
+            MYSTL_RETHROW;
+        }
+        destroy_and_recover(begin_, end_, cap_ - begin_);
+        begin_ = new_begin;
+        end_ = pos + 1;
+        cap_ = new_begin + new_cap;
+        return true;
+    }
+
+    // 追加 n 个由 gen() 生成的元素，生成或构造抛出异常时已追加的元素保留
+    template <class T, class Growth>
+    template <class Generator>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::append_n(size_type n, Generator gen) {
+        reserve_for_append(n);
+        for (; n > 0; --n, ++end_) {
+            data_allocator::construct(laistl::address_of(*end_), gen());
+        }
+    }
+
     // 弹出尾部元素 
-    template <class T>
-    void vector<T>::pop_back() {
-        MYSTL_DEBUG(!empty());
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::pop_back() {
+        MYSTL_CHECK_FAST(!empty());
         data_allocator::destroy(end_ - 1);
         --end_;
     }
 
     // 在pos处插入元素 
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::insert(const_iterator pos, const value_type& value) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 typename vector<T, Growth>::iterator
+    vector<T, Growth>::insert(const_iterator pos, const value_type& value) {
         MYSTL_DEBUG(pos >= begin() && pos <= end());
         iterator xpos = const_cast<iterator>(pos);
         const size_type n = pos - begin_;
@@ -399,9 +551,9 @@ namespace laistl {
     }
 
     // 删除pos位置上的元素 
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::erase(const_iterator pos) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 typename vector<T, Growth>::iterator
+    vector<T, Growth>::erase(const_iterator pos) {
         MYSTL_DEBUG(pos >= begin() && pos < end());
         iterator xpos = begin_ + (pos - begin());
         laistl::move(xpos + 1, end_, xpos);
@@ -411,10 +563,10 @@ namespace laistl {
     }
 
     // 删除[first, last)上的元素 
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::erase(const_iterator first, const_iterator last) {
-        MYSTL_DEBUG(first >= begin() && last < end() && !(last < first));
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 typename vector<T, Growth>::iterator
+    vector<T, Growth>::erase(const_iterator first, const_iterator last) {
+        MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
         const auto n = first - begin();
         iterator r = begin_ + (first - begin());
         data_allocator::destroy(laistl::move(r + (last - first), end_, r), end_);
@@ -422,9 +574,23 @@ namespace laistl {
         return begin_ + n;
     }
 
+    // 删除 pos 位置上的元素，把尾部元素移动到 pos，返回 pos
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 typename vector<T, Growth>::iterator
+    vector<T, Growth>::unordered_erase(const_iterator pos) {
+        MYSTL_DEBUG(pos >= begin() && pos < end());
+        iterator xpos = begin_ + (pos - begin());
+        if (xpos != end_ - 1) {
+            *xpos = laistl::move(*(end_ - 1));
+        }
+        data_allocator::destroy(end_ - 1);
+        --end_;
+        return xpos;
+    }
+
     // 重置容器大小 
-    template <class T>
-    void vector<T>::resize(size_type new_size, const value_type& value) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::resize(size_type new_size, const value_type& value) {
         if (new_size < size()) {
             erase(begin() + new_size, end());
         } else {
@@ -432,9 +598,29 @@ namespace laistl {
         }
     }
 
+    // 重置容器大小，新增元素默认初始化
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::resize_default_init(size_type new_size) {
+        if (new_size < size()) {
+            erase(begin() + new_size, end());
+            return;
+        }
+        reserve(new_size);
+        if (laistl::is_constant_evaluated()) {
+            // 常量求值中不能留下未初始化的值，改为值初始化
+            for (; end_ != begin_ + new_size; ++end_) {
+                data_allocator::construct(end_);
+            }
+            return;
+        }
+        for (; end_ != begin_ + new_size; ++end_) {
+            ::new (static_cast<void*>(end_)) T;
+        }
+    }
+
     // 与另一个 vector 交换
-    template <class T>
-    void vector<T>::swap(vector<T>& rhs) noexcept {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::swap(vector<T, Growth>& rhs) noexcept {
         if (this != &rhs) {
             laistl::swap(begin_, rhs.begin_);
             laistl::swap(end_, rhs.end_);
@@ -443,14 +629,15 @@ namespace laistl {
     }
 
     // helper functions
-    // try_init, 若分配失败则忽略，不抛出异常
-    template <class T>
-    void vector<T>::try_init() noexcept {
-        try {
-            begin_ = data_allocator::allocate(16);
+    // try_init, 若分配失败则忽略，不抛出异常；初始容量由增长策略决定，为 0 时不分配
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::try_init() noexcept {
+        MYSTL_TRY {
+            const size_type init_cap = Growth::initial(0, sizeof(T));
+            begin_ = init_cap == 0 ? nullptr : data_allocator::allocate(init_cap);
             end_ = begin_;
-            cap_ = begin_ + 16;
-        } catch (...) {
+            cap_ = begin_ + init_cap;
+        } MYSTL_CATCH_ALL {
             begin_ = nullptr;
             end_ = nullptr;
             cap_ = nullptr;
@@ -458,67 +645,116 @@ namespace laistl {
     }
 
     // init_space;
-    template <class T>
-    void vector<T>::init_space(size_type size, size_type cap) {
-        try {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::init_space(size_type size, size_type cap) {
+        MYSTL_TRY {
             begin_ = data_allocator::allocate(cap);
             end_ = begin_ + size;
             cap_ = begin_ + cap;
-        } catch (...) {
+        } MYSTL_CATCH_ALL {
             begin_ = nullptr;
             end_ = nullptr;
             cap_ = nullptr;
-            throw;
+            MYSTL_RETHROW;
         }
     }
 
     // fill_init
-    template <class T>
-    void vector<T>::fill_init(size_type n, const value_type& value) {
-        const size_type init_size = laistl::max(static_cast<size_type>(16), n);
-        init_space(n, init_size);
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::fill_init(size_type n, const value_type& value) {
+        init_space(n, Growth::initial(n, sizeof(T)));
         laistl::uninitialized_fill_n(begin_, n, value);
     }
 
-    // range_init
-    template <class T>
-    template <class Iter>
-    void vector<T>::range_init(Iter first, Iter last) {
-        const size_type init_size = laistl::max(static_cast<size_type>(last - first), 
-                                               static_cast<size_type>(16));
-        init_space(static_cast<size_type>(last - first), init_size);
-        laistl::uninitialized_fill_n(first, last, begin_);
+    // range_init: 输入迭代器无法预先得知长度，按块读入
+    template <class T, class Growth>
+    template <class IIter>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::range_init(IIter first, IIter last, input_iterator_tag) {
+        try_init();
+        MYSTL_TRY {
+            ingest(first, last);
+        } MYSTL_CATCH_ALL {
+            destroy_and_recover(begin_, end_, cap_ - begin_);
+            MYSTL_RETHROW;
+        }
+    }
+
+    template <class T, class Growth>
+    template <class FIter>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::range_init(FIter first, FIter last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(laistl::distance(first, last));
+        init_space(n, Growth::initial(n, sizeof(T)));
+        MYSTL_TRY {
+            laistl::uninitialized_copy(first, last, begin_);
+        } MYSTL_CATCH_ALL {
+            data_allocator::deallocate(begin_, cap_ - begin_);
+            MYSTL_RETHROW;
+        }
     }
 
     // destroy_and_recover 
-    template <class T>
-    void vector<T>::destroy_and_recover(iterator first, iterator last, size_type n) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::destroy_and_recover(iterator first, iterator last, size_type n) {
         // destructor
         data_allocator::destroy(first, last);
         // delete
         data_allocator::deallocate(first, n);
     }
     
-    // get_new_cap
-    template <class T>
-    typename vector<T>::size_type
-    vector<T>::get_new_cap(size_type add_size) {
-        const auto old_size = capacity();
-        THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size, "vector<T>'s size too big");
-        if (old_size > max_size() - old_size / 2) {
-            return old_size + add_size > max_size() - 16 ?
-                old_size + add_size : old_size + add_size + 16;
-        }
-        const size_type new_size = old_size == 0 ?
-            laistl::max(add_size, static_cast<size_type>(16)) :
-            laistl::max(old_size + old_size / 2, old_size + add_size);
-        
-        return new_size;
+    // get_new_cap: 容纳新增 add_size 个元素所需的容量，由增长策略决定
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 typename vector<T, Growth>::size_type
+    vector<T, Growth>::get_new_cap(size_type add_size) {
+        THROW_LENGTH_ERROR_IF(size() > max_size() - add_size, "vector<T>'s size too big");
+        const size_type need = size() + add_size;
+        const size_type new_cap = Growth::grow(capacity(), need, max_size(), sizeof(T));
+        MYSTL_DEBUG(new_cap >= need && new_cap <= max_size());
+        return new_cap;
+    }
+
+    // reserve_for_append: 保证尾部至少还能容纳 n 个元素，按增长策略扩容使反复追加均摊为常数
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::reserve_for_append(size_type n) {
+        if (static_cast<size_type>(cap_ - end_) < n) {
+            reserve(get_new_cap(n));
+        }
+    }
+
+    // ingest: 把单遍输入区间按块读入尾部的未初始化空间
+    // 每块开始时检查一次容量并按增长策略扩容，块内只比较输入是否结束和是否写满
+    // 抛出异常时已读入的元素保留，first 停在出错的位置
+    template <class T, class Growth>
+    template <class IIter>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::ingest(IIter& first, IIter last) {
+        while (first != last) {
+            if (end_ == cap_) {
+                reserve(get_new_cap(1));
+            }
+            for (; first != last && end_ != cap_; ++first, ++end_) {
+                data_allocator::construct(laistl::address_of(*end_), *first);
+            }
+        }
+    }
+
+    // append_range_dispatch: 输入迭代器无法预先得知长度，按块读入
+    template <class T, class Growth>
+    template <class IIter>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::append_range_dispatch(IIter first, IIter last, input_iterator_tag) {
+        ingest(first, last);
+    }
+
+    // 前向迭代器先计算长度，扩容一次后用 uninitialized_copy 整段构造，平凡类型的指针区间走 memmove
+    template <class T, class Growth>
+    template <class FIter>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::append_range_dispatch(FIter first, FIter last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(laistl::distance(first, last));
+        reserve_for_append(n);
+        end_ = laistl::uninitialized_copy(first, last, end_);
     }
 
     // fill_assign
-    template <class T>
-    void vector<T>::fill_assign(size_type n, const value_type& value) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::fill_assign(size_type n, const value_type& value) {
         if (n > capacity()) {
             vector tmp(n, value);
             swap(tmp);
@@ -531,9 +767,9 @@ namespace laistl {
     }
 
     // copy_assign
-    template <class T>
+    template <class T, class Growth>
     template <class IIter>
-    void vector<T>::copy_assign(IIter first, IIter last, input_iterator_tag) {
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::copy_assign(IIter first, IIter last, input_iterator_tag) {
         auto cur = begin_;
         for (; first != last && cur != end_; ++first, ++cur) {
             *cur = *first;
@@ -546,9 +782,9 @@ namespace laistl {
     }
 
     // 用[first, last] 为容器赋值
-    template <class T>
+    template <class T, class Growth>
     template <class FIter>
-    void vector<T>::copy_assign(FIter first, FIter last, forward_iterator_tag) {
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::copy_assign(FIter first, FIter last, forward_iterator_tag) {
         const size_type len = laistl::distance(first, last);
         if (len > capacity()) {
             vector tmp(first, last);
@@ -567,20 +803,21 @@ namespace laistl {
     }
  
     // 重新分配空间并在pos处就地构造元素
-    template <class T>
+    template <class T, class Growth>
     template <class ...Args>
-    void vector<T>::reallocate_emplace(iterator pos, Args&& ...args) {
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::reallocate_emplace(iterator pos, Args&& ...args) {
+        MYSTL_PERF_HOOK("vector::reallocate_emplace");
         const auto new_size = get_new_cap(1);
         auto new_begin = data_allocator::allocate(new_size);
         auto new_end = new_begin;
-        try {
+        MYSTL_TRY {
             new_end = laistl::uninitialized_move(begin_, pos, new_begin);
             data_allocator::construct(laistl::address_of(*new_end), laistl::forward<Args>(args)...);
             ++new_end;
             new_end = laistl::uninitialized_move(pos, end_, new_end);  
-        } catch (...) {
+        } MYSTL_CATCH_ALL {
             data_allocator::deallocate(new_begin, new_size);
-            throw;  
+            MYSTL_RETHROW;  
         }
         destroy_and_recover(begin_, end_, cap_ - begin_);
         begin_ = new_begin;
@@ -589,20 +826,21 @@ namespace laistl {
     }
 
     // 重新分配空间并在pos处插入元素
-    template <class T>
-    void vector<T>::reallocate_insert(iterator pos, const value_type& value) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::reallocate_insert(iterator pos, const value_type& value) {
+        MYSTL_PERF_HOOK("vector::reallocate_insert");
         const auto new_size = get_new_cap(1);
         auto new_begin = data_allocator::allocate(new_size);
         auto new_end = new_begin;
         const value_type& value_copy = value;
-        try {
+        MYSTL_TRY {
             new_end = laistl::uninitialized_move(begin_, pos, new_begin);
             data_allocator::construct(laistl::address_of(*new_end), value_copy);
             ++new_end;
             new_end = laistl::uninitialized_move(pos, end_, new_end);  
-        } catch (...) {
+        } MYSTL_CATCH_ALL {
             data_allocator::deallocate(new_begin, new_size);
-            throw;  
+            MYSTL_RETHROW;  
         }
         destroy_and_recover(begin_, end_, cap_ - begin_);
         begin_ = new_begin;
@@ -611,9 +849,9 @@ namespace laistl {
     }
 
     // fill_insert
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 typename vector<T, Growth>::iterator
+    vector<T, Growth>::fill_insert(iterator pos, size_type n, const value_type& value) {
         if (n == 0) {
             return pos;
         }
@@ -626,23 +864,23 @@ namespace laistl {
                 laistl::uninitialized_copy(end_ - n, end_, end_);
                 end_ += n;
                 laistl::move_backward(pos, old_end - n, old_end);
-                laistl::uninitialized_fill_n(pos, n, value_copy);
+                laistl::fill_n(pos, n, value_copy);
             } else {
-                end_ = laistl::uninitialized_fill_n(end_, n - af, value_copy);
+                end_ = laistl::uninitialized_fill_n(end_, n - after_elems, value_copy);
                 end_ = laistl::uninitialized_move(pos, old_end, end_);
-                laistl::uninitialized_fill_n(pos, after_elems, value_copy);
+                laistl::fill_n(pos, after_elems, value_copy);
             }
         } else {
             const auto new_size = get_new_cap(n);
             auto new_begin = data_allocator::allocate(new_size);
             auto new_end = new_begin;
-            try {
+            MYSTL_TRY {
                 new_end = laistl::uninitialized_move(begin_, pos, new_begin);
                 new_end = laistl::uninitialized_fill_n(new_end, n, value);
                 new_end = laistl::uninitialized_move(pos, end_, new_end);  
-            } catch (...) {
+            } MYSTL_CATCH_ALL {
                 destroy_and_recover(new_begin, new_end, new_size);
-                throw;  
+                MYSTL_RETHROW;  
             }
             data_allocator::deallocate(begin_, cap_ - begin_);
             begin_ = new_begin;
@@ -652,10 +890,22 @@ namespace laistl {
         return begin_ + xpos;
     }
 
-    // copy_insert
-    template <class T>
+    // copy_insert: 输入迭代器只能遍历一次，在尾部插入时直接读入，否则先读入临时 vector 再整段移动插入
+    template <class T, class Growth>
     template <class IIter>
-    void vector<T>::copy_insert(iterator pos, IIter first, IIter last) {
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::copy_insert(iterator pos, IIter first, IIter last, input_iterator_tag) {
+        if (pos == end_) {
+            ingest(first, last);
+            return;
+        }
+        vector tmp(first, last);
+        copy_insert(pos, laistl::make_move_iterator(tmp.begin_), laistl::make_move_iterator(tmp.end_),
+                    random_access_iterator_tag());
+    }
+
+    template <class T, class Growth>
+    template <class FIter>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::copy_insert(iterator pos, FIter first, FIter last, forward_iterator_tag) {
         if (first == last) {
             return ;
         }
@@ -666,25 +916,25 @@ namespace laistl {
             if (after_elems > n) {
                 end_ = laistl::uninitialized_copy(end_ - n, end_, end_);
                 laistl::move_backward(pos, old_end - n, old_end);
-                laistl::uninitialized_copy(first, last, pos);
+                laistl::copy(first, last, pos);
             } else {
                 auto mid = first;
                 laistl::advance(mid, after_elems);
                 end_ = laistl::uninitialized_copy(mid, last, end_);
                 end_ = laistl::uninitialized_move(pos, old_end, end_);
-                laistl::uninitialized_copy(first, mid, pos);
+                laistl::copy(first, mid, pos);
             }
         } else {
             const auto new_size = get_new_cap(n);
             auto new_begin = data_allocator::allocate(new_size);
             auto new_end = new_begin;
-            try {
+            MYSTL_TRY {
                 new_end = laistl::uninitialized_move(begin_, pos, new_begin);
                 new_end = laistl::uninitialized_copy(first, last, new_end);
                 new_end = laistl::uninitialized_move(pos, end_, new_end);  
-            } catch (...) {
+            } MYSTL_CATCH_ALL {
                 destroy_and_recover(new_begin, new_end, new_size);
-                throw;  
+                MYSTL_RETHROW;  
             }
             data_allocator::deallocate(begin_, cap_ - begin_);
             begin_ = new_begin;
@@ -694,14 +944,14 @@ namespace laistl {
     }
 
     // reinsert
-    template <class T>
-    void vector<T>::reinsert(size_type size) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void vector<T, Growth>::reinsert(size_type size) {
         auto new_begin = data_allocator::allocate(size);
-        try {
+        MYSTL_TRY {
             laistl::uninitialized_move(begin_, end_, new_begin);
-        } catch (...) {
+        } MYSTL_CATCH_ALL {
             data_allocator::deallocate(new_begin, size);
-            throw;   
+            MYSTL_RETHROW;   
         }
         data_allocator::deallocate(begin_, cap_ - begin_);
         begin_ = new_begin;
@@ -710,42 +960,96 @@ namespace laistl {
     }
 
     // 重载比较运算符
-    template <class T>
-    bool operator==(const vector<T>& lhs, const vector<T>& rhs) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 bool operator==(const vector<T, Growth>& lhs, const vector<T, Growth>& rhs) {
         return lhs.size() == rhs.size() && laistl::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template <class T>
-    bool operator<(const vector<T>& lhs, const vector<T>& rhs) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 bool operator<(const vector<T, Growth>& lhs, const vector<T, Growth>& rhs) {
         return laistl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
     
-    template <class T>
-    bool operator!=(const vector<T>& lhs, const vector<T>& rhs) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 bool operator!=(const vector<T, Growth>& lhs, const vector<T, Growth>& rhs) {
         return !(lhs == rhs);
     }
 
-    template <class T>
-    bool operator>(const vector<T>& lhs, const vector<T>& rhs) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 bool operator>(const vector<T, Growth>& lhs, const vector<T, Growth>& rhs) {
         return rhs < lhs;
     }
     
-    template <class T>
-    bool operator<=(const vector<T>& lhs, const vector<T>& rhs) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 bool operator<=(const vector<T, Growth>& lhs, const vector<T, Growth>& rhs) {
         return !(rhs < lhs);
     }
 
-    template <class T>
-    bool operator>=(const vector<T>& lhs, const vector<T>& rhs) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 bool operator>=(const vector<T, Growth>& lhs, const vector<T, Growth>& rhs) {
         return !(lhs < rhs);
     }
 
     // 重载 swap 
-    template <class T>
-    void swap(vector<T>& lhs, vector<T>& rhs) {
+    template <class T, class Growth>
+    MYSTL_CONSTEXPR20 void swap(vector<T, Growth>& lhs, vector<T, Growth>& rhs) {
         lhs.swap(rhs);
     }
 
+    // erase_if: 一次遍历删除所有满足 pred 的元素，尾部只销毁一次，返回删除的个数
+    template <class T, class Growth, class Predicate>
+    MYSTL_CONSTEXPR20 typename vector<T, Growth>::size_type erase_if(vector<T, Growth>& v, Predicate pred) {
+        auto it = laistl::remove_if(v.begin(), v.end(), pred);
+        const auto n = static_cast<typename vector<T, Growth>::size_type>(v.end() - it);
+        v.erase(it, v.end());
+        return n;
+    }
+
+    // read_into: 从 source 按块读入可按位复制的元素，追加到 v 的尾部，返回读入的元素个数
+    // source(T* buf, size_t n) 向 buf 写入至多 n 个元素并返回写入的个数，返回 0 表示数据结束
+    // 每块之前按增长策略保证尾部至少有 block 个元素的空间，数据直接写入 vector 的缓冲区
+    template <class T, class Growth, class Source>
+    typename vector<T, Growth>::size_type
+    read_into(vector<T, Growth>& v, Source source, typename vector<T, Growth>::size_type block = 0) {
+        static_assert(std::is_trivially_copyable<T>::value, "read_into requires a trivially copyable T");
+        typedef typename vector<T, Growth>::size_type size_type;
+        if (block == 0) {
+            block = sizeof(T) >= 4096 ? 1 : 4096 / sizeof(T);
+        }
+        const size_type old_size = v.size();
+        for (;;) {
+            const size_type size = v.size();
+            if (v.capacity() - size < block) {
+                THROW_LENGTH_ERROR_IF(size > v.max_size() - block, "vector<T>'s size too big");
+                v.reserve(Growth::grow(v.capacity(), size + block, v.max_size(), sizeof(T)));
+            }
+            v.resize_default_init(v.capacity());
+            size_type n = 0;
+            MYSTL_TRY {
+                n = static_cast<size_type>(source(v.data() + size, v.capacity() - size));
+            } MYSTL_CATCH_ALL {
+                v.resize_default_init(size);
+                MYSTL_RETHROW;
+            }
+            MYSTL_DEBUG(n <= v.capacity() - size);
+            v.resize_default_init(size + n);
+            if (n == 0) {
+                break;
+            }
+        }
+        return v.size() - old_size;
+    }
+
+    // erase: 删除所有等于 value 的元素，返回删除的个数
+    template <class T, class Growth, class U>
+    MYSTL_CONSTEXPR20 typename vector<T, Growth>::size_type erase(vector<T, Growth>& v, const U& value) {
+        auto it = laistl::remove(v.begin(), v.end(), value);
+        const auto n = static_cast<typename vector<T, Growth>::size_type>(v.end() - it);
+        v.erase(it, v.end());
+        return n;
+    }
+
+} /* inline namespace MYSTL_HARDENING_NAMESPACE */
 } /* namespace laistl */
 
 #endif /* _VECTOR_H */